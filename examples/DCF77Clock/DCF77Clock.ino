@@ -27,6 +27,8 @@
  */
 
 #include "DCF77rxtm.h"
+#include "DCF77wallclock.h"
+#include "DCF77frameSlot.h"
 
 /**
  * The clock needs an initial Dcf77 frame to start. Seconds
@@ -58,7 +60,7 @@ class DCF77Clock : public DCF77rx<DCF77_PIN> {
 
 public:
   DCF77Clock()
-    : mLastDcf77Frame(0), mState(INVALID), mSystickAtLastFrame(0), mAlarm(IN_SYNC) {
+    : mReportedSequence(0), mAlarm(IN_SYNC) {
   }
 
   void begin() {
@@ -77,70 +79,63 @@ public:
    * @return false, as long as no Dcf77 frame was received.
    */
   bool getTime(DCF77::tm& tm, unsigned* millisec) {
-    if(mState != INVALID) {
-      // Disable interrupts to avoid race condition with onDCF77FrameReceived()
-      // which is updating mSystickAtLastFrame and mLastDcf77Frame.
-      noInterrupts();
-      const uint32_t millisSinceLastFrame = millis() - mSystickAtLastFrame;
-      const uint64_t dcf77frame = mLastDcf77Frame;
-      interrupts();
-
-      const uint32_t secSinceLastFrame = millisSinceLastFrame / 1000;
-      dcf77frame2time(tm, dcf77frame);
-      const DCF77::time_t timestamp = DCF77::tm_to_timestamp(tm);
-
-      DCF77::timestamp_to_tm(tm, timestamp + secSinceLastFrame, tm.tm_isdst);
-      if(millisec != nullptr) {
-        *millisec = millisSinceLastFrame % 1000;
-      }
-      return true;
-    }
-    return false;
+    // The wall clock converts each frame only once and advances
+    // the time incrementally in between.
+    return mWallclock.getTime(tm, millisec);
+  }
+
+  /**
+   * The wall clock corrects the drift of millis(), that it has
+   * estimated from the received frames.
+   */
+  const DCF77wallclock& wallclock() const {
+    return mWallclock;
   }
 
   bool checkAlarm() {
-    // State is queried 2 times below. Hence save mState in state to avoid
-    // race condition with interrupt calling onDCF77FrameReceived().
-    STATE state = mState;
+    // A consistent copy of the frame, its systick and its sequence
+    // number, even if onDCF77FrameReceived() interrupts the read out.
+    DCF77frameSnapshot lastFrame;
+    const bool newFrame = mLastFrame.read(lastFrame)
+        && lastFrame.sequence != mReportedSequence;
 
     if(mAlarm == IN_SYNC) {
-      // Save mSystickAtLastFrame in systickAtLastFrame for the calculation
-      // of millisSinceLastFrame to avoid a race condition.
-      // If we would get an interrupt calling onDCF77FrameReceived()
-      // after the call of millis(), we would get a negative
-      // result for the calculation of millis() - systickAtLastFrame,
-      // and millisSinceLastFrame would be wrong.
-      const uint32_t systickAtLastFrame = mSystickAtLastFrame;
-      const uint32_t millisSinceLastFrame = millis() - systickAtLastFrame;
+      // The copy is taken before the call of millis(). If we would get
+      // an interrupt calling onDCF77FrameReceived() in between, we would
+      // get a negative result for the calculation of millis() -
+      // lastFrame.systick, and millisSinceLastFrame would be wrong.
+      const uint32_t millisSinceLastFrame = millis() - lastFrame.systick;
       if(static_cast<uint32_t>(DCF77_FRAME_MISSING_ALARM_TIMEOUT) * MSEC_PER_MINUTE
           <= millisSinceLastFrame) {
         mAlarm = OUT_OF_SYNCH;
         digitalWrite(LED_CLOCK_OUT_OF_SYNCH_ALARM, HIGH);
         Serial.println("Alarm: Dcf77 connection lost.");
+        if(mWallclock.hasDriftEstimate()) {
+          Serial.print("Running on with drift correction of ");
+          Serial.print(mWallclock.driftPpm());
+          Serial.println(" ppm.");
+        }
       } else {
-        if(state == VALID) {
+        if(newFrame) {
           digitalWrite(LED_CLOCK_OUT_OF_SYNCH_ALARM, LOW);
         }
       }
     } else {
-      if(mAlarm == SYNCH_RECOVERED) {
+      if(newFrame) {
         mAlarm = IN_SYNC;
         digitalWrite(LED_CLOCK_OUT_OF_SYNCH_ALARM, LOW);
         Serial.println("Alarm: Dcf77 connection recovered.");
       }
     }
 
-    if(state == VALID) {
+    if(newFrame) {
 #if PRINT_DCF77FRAME_EVENT
-      noInterrupts();
-      const uint64_t dcf77frame = mLastDcf77Frame;
-      interrupts();
       PrintableDCF77tm tm;
-      dcf77frame2time(tm, dcf77frame);
+      dcf77frame2time(tm, lastFrame.frame);
       Serial.print("Dcf77 frame received: ");
       Serial.println(tm);
 #endif
-      mState = VALID_AND_REPORTED;
+      mReportedSequence = lastFrame.sequence;
     }
 
     return mAlarm;
@@ -153,21 +148,17 @@ private:
    * priority interrupts to be serviced.
    */
   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
-    mSystickAtLastFrame = systick;
-    mLastDcf77Frame = dcf77frame;
-    mState = VALID;
-    if(mAlarm == OUT_OF_SYNCH) {
-      mAlarm = SYNCH_RECOVERED;
-    }
+    mWallclock.update(dcf77frame, systick);
+    mLastFrame.publish(dcf77frame, systick);
   }
 
-  uint32_t mSystickAtLastFrame;
-  uint64_t mLastDcf77Frame;
-
-  enum STATE : int8_t {INVALID, VALID, VALID_AND_REPORTED};
-  STATE mState;
+  DCF77wallclock mWallclock;
+  // Written by the interrupt, read by checkAlarm().
+  DCF77frameSlot mLastFrame;
+  // The sequence number of the frame, that checkAlarm() has seen.
+  uint32_t mReportedSequence;
 
-  enum ALARM : int8_t {OUT_OF_SYNCH, SYNCH_RECOVERED, IN_SYNC};
+  enum ALARM : int8_t {OUT_OF_SYNCH, IN_SYNC};
   ALARM mAlarm;
 };
 
@@ -200,7 +191,10 @@ void loop()
     if(dcf77Clock.getTime(tm, nullptr) ) {
       Serial.print(tm);
       Serial.print(", isdst=");
-      Serial.println(tm.tm_isdst);
+      Serial.print(tm.tm_isdst);
+      Serial.print(", error <= ");
+      Serial.print(dcf77Clock.wallclock().holdoverErrorMillis());
+      Serial.println("ms");
     } else {
       Serial.print('[');
       Serial.print(counter);
@@ -28,33 +28,28 @@
  */
 
 #include "DCF77rxtm.h"
+#include "DCF77frameSlot.h"
 
 static constexpr int DCF77_PIN = 2;
 
 static constexpr size_t PRINTOUT_PERIOD = 1;
 static int32_t counter = 0;
 static uint32_t lastSystick = 0;
+static uint32_t printedSequence = 0;
 
 class MyDCF77Receiver : public DCF77rx<DCF77_PIN> {
-  uint64_t mDcf77frame = 0;
-
   /**
    * This function runs within the interrupt context and must be executed
    * quickly in order not to prevent other lower priority interrupts to
    * be serviced.
    */
   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
-    counter = -1;
-    mDcf77frame = dcf77frame;
+    latestFrame.publish(dcf77frame, systick);
   }
 
 public:
-  uint64_t getDCF77frame() const {
-    noInterrupts();
-    const uint64_t result = mDcf77frame;
-    interrupts();
-    return result;
-  }
+  // Passes the frames to loop() without disabling interrupts.
+  DCF77frameSlot latestFrame;
 };
 
 MyDCF77Receiver myReceiver;
@@ -75,16 +70,16 @@ void loop()
 {
   const uint32_t systick = millis();
   if(systick - lastSystick >= PRINTOUT_PERIOD * 1000) {
-    if(counter < 0) {
+    DCF77frameSnapshot latest;
+    if(myReceiver.latestFrame.read(latest) && latest.sequence != printedSequence) {
       // Frame received.
-      const uint64_t dcf77frame = myReceiver.getDCF77frame();
-      if( dcf77frame ) {
-        // convert frame to time structure.
-        PrintableDCF77tm time;
-        myReceiver.dcf77frame2time(time, dcf77frame);
-        Serial.print("DCF77 frame received: ");
-        Serial.println(time);
-      }
+      printedSequence = latest.sequence;
+      counter = -1;
+      // convert frame to time structure.
+      PrintableDCF77tm time;
+      myReceiver.dcf77frame2time(time, latest.frame);
+      Serial.print("DCF77 frame received: ");
+      Serial.println(time);
     } else {
       // Waiting for next frame;
       Serial.print('[');
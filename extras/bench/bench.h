@@ -0,0 +1,169 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Common helpers for the host benchmarks: a monotonic timer, a sink that
+ * keeps the optimizer from discarding results and a DCF77 pulse train
+ * encoder that produces valid frames for the decoder under test.
+ */
+
+#pragma once
+
+#ifndef DCF77_BENCH_H_
+#define DCF77_BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+
+#include <Arduino.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+inline uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Time stamp counter for cycle counts. On x86 this is the TSC, which
+ * ticks with the nominal core frequency. Other hosts fall back to
+ * nanoseconds.
+ */
+inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return nowNs();
+#endif
+}
+
+/** Keep v alive, so that the computation producing it is not optimized away. */
+template<typename T> inline void doNotOptimize(const T& v) {
+  asm volatile("" : : "g"(&v) : "memory");
+}
+
+/**
+ * Measure the clock ticks per operation of f, which is expected to
+ * perform ops operations per call. The best of several rounds is
+ * returned to reduce the influence of the scheduler.
+ */
+template<typename CLOCK, typename F> double ticksPerOp(CLOCK clock, size_t ops, F f) {
+  static constexpr int ROUNDS = 7;
+  f(); // warm up
+  double best = 0;
+  for (int i = 0; i < ROUNDS; i++) {
+    const uint64_t start = clock();
+    f();
+    const double ticks = static_cast<double>(clock() - start) / ops;
+    if (i == 0 || ticks < best) {
+      best = ticks;
+    }
+  }
+  return best;
+}
+
+template<typename F> double nsPerOp(size_t ops, F f) {
+  return ticksPerOp(nowNs, ops, f);
+}
+
+template<typename F> double cyclesPerOp(size_t ops, F f) {
+  return ticksPerOp(cycles, ops, f);
+}
+
+inline void report(const char* name, double value, const char* unit) {
+  printf("%-40s %12.2f %s\n", name, value, unit);
+}
+
+inline unsigned toBcd(unsigned v) {
+  return ((v / 10) << 4) | (v % 10);
+}
+
+inline unsigned parity(uint64_t v) {
+  return __builtin_popcountll(v) & 1;
+}
+
+/**
+ * Encode a DCF77 frame. Weekday is 1 (Monday) to 7 (Sunday), month is
+ * 1 to 12, year is 0 to 99.
+ */
+inline uint64_t encodeFrame(unsigned year, unsigned month, unsigned mday,
+    unsigned wday, unsigned hour, unsigned minute, bool cest) {
+  const uint64_t min = toBcd(minute);
+  const uint64_t hr = toBcd(hour);
+  const uint64_t date = toBcd(mday) | (static_cast<uint64_t>(wday) << 6)
+      | (static_cast<uint64_t>(toBcd(month)) << 9)
+      | (static_cast<uint64_t>(toBcd(year)) << 14);
+  uint64_t frame = 0;
+  frame |= static_cast<uint64_t>(cest ? 1 : 0) << 17;
+  frame |= static_cast<uint64_t>(cest ? 0 : 1) << 18;
+  frame |= static_cast<uint64_t>(1) << 20;
+  frame |= (min | static_cast<uint64_t>(parity(min)) << 7) << 21;
+  frame |= (hr | static_cast<uint64_t>(parity(hr)) << 6) << 29;
+  frame |= (date | static_cast<uint64_t>(parity(date)) << 22) << 36;
+  return frame;
+}
+
+struct Edge {
+  uint64_t us;
+  int level;
+};
+
+/**
+ * Append the pulse train of one minute to edges. The second marks are
+ * low pulses of 100ms (bit 0) or 200ms (bit 1). Second 59 carries no
+ * mark.
+ *
+ * @param startUs Time of the second 0 mark in microseconds.
+ */
+inline void appendMinute(std::vector<Edge>& edges, uint64_t frame, uint64_t startUs) {
+  for (unsigned sec = 0; sec < 59; sec++) {
+    const uint64_t mark = startUs + sec * 1000000ULL;
+    const uint64_t width = (frame >> sec) & 1 ? 200000 : 100000;
+    edges.push_back(Edge{mark, LOW});
+    edges.push_back(Edge{mark + width, HIGH});
+  }
+}
+
+/**
+ * Feed edges through the simulated pin, which invokes the pin interrupt.
+ *
+ * @param offsetUs Added to the edge time stamps, so that a pulse train
+ *  can be replayed several times with monotonic time.
+ */
+inline void replay(const std::vector<Edge>& edges, uint8_t pin, uint64_t offsetUs = 0) {
+  for (const Edge& e : edges) {
+    ArduinoHost::setMicros(e.us + offsetUs);
+    ArduinoHost::setPinLevel(pin, e.level);
+  }
+}
+
+} // namespace bench
+
+#endif /* DCF77_BENCH_H_ */
@@ -0,0 +1,318 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host simulation of the time to first fix of DCF77accumulator against
+ * the plain receiver, which needs one minute without error.
+ *
+ * Before, dcf77time2frame() is checked against the frames of the bench
+ * encoder, and the accumulator is checked to predict the frames across
+ * both CET / CEST changes of a year.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DCF77accumulator.h"
+#include "bench.h"
+
+namespace {
+
+constexpr uint8_t PIN = 3;
+constexpr uint32_t MINUTE_MS = 60000;
+constexpr unsigned MAX_MINUTES = 45;
+
+time_t lastSundayAt1Utc(int year, int month) {
+  struct tm t;
+  memset(&t, 0, sizeof(t));
+  t.tm_year = year - 1900;
+  t.tm_mon = month - 1;
+  t.tm_mday = 31;
+  t.tm_hour = 1;
+  time_t ts = timegm(&t);
+  gmtime_r(&ts, &t);
+  return ts - t.tm_wday * 86400;
+}
+
+/**
+ * The frame that announces the minute beginning at utc, with the EU
+ * rules for CEST and the announcement bit A1 in the hour before a change.
+ */
+uint64_t frameAt(time_t utc) {
+  struct tm t;
+  gmtime_r(&utc, &t);
+  const time_t spring = lastSundayAt1Utc(t.tm_year + 1900, 3);
+  const time_t autumn = lastSundayAt1Utc(t.tm_year + 1900, 10);
+  const bool cest = utc >= spring && utc < autumn;
+  const bool a1 = (utc >= spring - 3600 && utc < spring) || (utc >= autumn - 3600 && utc < autumn);
+  const time_t local = utc + (cest ? 7200 : 3600);
+  DCF77::tm lt;
+  gmtime_r(&local, &lt);
+  lt.tm_isdst = cest;
+  return DCF77rxbase::dcf77time2frame(lt) | (a1 ? DCF77frame::A1::frameMask() : 0);
+}
+
+unsigned verifyEncoder() {
+  unsigned failures = 0;
+  std::mt19937 rng(3);
+  for (time_t utc = 946684800; utc < 4102444800LL - 86400; utc += 3600) {
+    const time_t local = utc + 60 * (rng() % 60);
+    DCF77::tm t;
+    gmtime_r(&local, &t);
+    t.tm_isdst = rng() & 1;
+    const uint64_t frame = DCF77rxbase::dcf77time2frame(t);
+    const unsigned wday = t.tm_wday == 0 ? 7 : t.tm_wday;
+    const uint64_t expected = bench::encodeFrame(t.tm_year - 100, t.tm_mon + 1, t.tm_mday,
+        wday, t.tm_hour, t.tm_min, t.tm_isdst);
+    DCF77::tm back;
+    DCF77rxbase::dcf77frame2time(back, frame);
+    if (frame != expected || back.tm_min != t.tm_min || back.tm_hour != t.tm_hour
+        || back.tm_mday != t.tm_mday || back.tm_mon != t.tm_mon || back.tm_year != t.tm_year
+        || back.tm_wday != t.tm_wday || back.tm_isdst != t.tm_isdst) {
+      failures++;
+    }
+  }
+  return failures;
+}
+
+class CollectingAccumulator : public DCF77accumulator {
+public:
+  std::vector<std::pair<uint64_t, uint32_t>> mFrames;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mFrames.push_back(std::make_pair(dcf77frame, systick));
+  }
+};
+
+/** Feed 3 hours of clean frames around both changes of 2025. */
+unsigned verifyDstChange() {
+  unsigned failures = 0;
+  const time_t changes[] = {lastSundayAt1Utc(2025, 3), lastSundayAt1Utc(2025, 10)};
+  for (const time_t change : changes) {
+    CollectingAccumulator accumulator;
+    const time_t start = change - 2 * 3600 + 17 * 60;
+    for (uint32_t m = 0; m < 180; m++) {
+      accumulator.onMinuteSync(frameAt(start + 60 * m), DCF77frame::BIT_COUNT, m * MINUTE_MS);
+    }
+    if (accumulator.mFrames.size() < 170) {
+      failures++;
+    }
+    for (const auto& f : accumulator.mFrames) {
+      if (f.first != frameAt(start + 60 * (f.second / MINUTE_MS))) {
+        failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+/**
+ * Lock on clean minutes, then let dropouts within the minute pose as
+ * minute marks. Every frame must be delivered once, at the minute mark.
+ * The very first mark is a dropout, too.
+ */
+unsigned verifyDropouts() {
+  unsigned failures = 0;
+  CollectingAccumulator accumulator;
+  const time_t start = 1767225600; // 2026-01-01 00:00 UTC
+  const uint32_t firstMarkMs = MINUTE_MS;
+  accumulator.onMinuteSync(0, 17, firstMarkMs - 25000);
+  uint32_t expected = 0;
+  for (uint32_t m = 0; m < 30; m++) {
+    const uint32_t markMs = firstMarkMs + m * MINUTE_MS;
+    // Every other minute, a dropout 35s or 10s after its mark.
+    const uint32_t dropoutMs = m % 4 == 1 ? 35000 : 10000;
+    const bool dropout = m > 0 && m % 2 == 1;
+    if (dropout) {
+      accumulator.onMinuteSync(frameAt(start + 60 * (m - 1)), dropoutMs / 1000 - 1,
+          markMs - MINUTE_MS + dropoutMs);
+    }
+    const bool wasLocked = accumulator.isLocked();
+    accumulator.onMinuteSync(frameAt(start + 60 * m) >> (dropout ? dropoutMs / 1000 : 0),
+        dropout ? DCF77frame::BIT_COUNT - dropoutMs / 1000 : DCF77frame::BIT_COUNT, markMs);
+    expected += wasLocked || accumulator.isLocked();
+  }
+  if (accumulator.mFrames.size() != expected || expected < 20) {
+    failures++;
+  }
+  uint32_t previousMs = 0;
+  for (const auto& f : accumulator.mFrames) {
+    const uint32_t minute = (f.second - firstMarkMs) / MINUTE_MS;
+    if (f.second <= previousMs || (f.second - firstMarkMs) % MINUTE_MS != 0
+        || f.first != frameAt(start + 60 * minute)) {
+      failures++;
+    }
+    previousMs = f.second;
+  }
+  return failures;
+}
+
+struct Fix {
+  int receiver = -1;       // minutes to the first correct frame, -1 if none
+  int accumulator = -1;
+  unsigned receiverWrong = 0;
+  unsigned accumulatorWrong = 0;
+  int64_t receiverMinute = -1;     // the minute of the latest frame
+  int64_t accumulatorMinute = -1;
+};
+
+/* Frames are checked against the minute of their systick. A frame
+   off the minute mark or a second one for the same minute is wrong. */
+struct Expected {
+  time_t mUtcAtFirstMark;
+  uint32_t mFirstMarkMs;
+
+  bool check(uint64_t frame, uint32_t systick, int& fix, unsigned& wrong, int64_t& lastMinute) const {
+    const uint32_t minute = (systick - mFirstMarkMs + MINUTE_MS / 2) / MINUTE_MS;
+    const int32_t offMs = static_cast<int32_t>(systick - mFirstMarkMs - minute * MINUTE_MS);
+    const bool ok = frame == frameAt(mUtcAtFirstMark + 60 * minute)
+        && offMs > -1000 && offMs < 1000 && minute != lastMinute;
+    lastMinute = minute;
+    if (not ok) {
+      wrong++;
+    } else if (fix < 0) {
+      fix = static_cast<int>((systick + MINUTE_MS - 1) / MINUTE_MS);
+    }
+    return ok;
+  }
+};
+
+Expected gExpected;
+Fix gFix;
+
+class Receiver : public DCF77rx<PIN> {
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    gExpected.check(dcf77frame, systick, gFix.receiver, gFix.receiverWrong, gFix.receiverMinute);
+  }
+};
+
+class Accumulator : public DCF77accumulator {
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    gExpected.check(dcf77frame, systick, gFix.accumulator, gFix.accumulatorWrong,
+        gFix.accumulatorMinute);
+  }
+};
+
+/**
+ * Boot at a random time and receive MAX_MINUTES minutes with Gaussian
+ * edge jitter sigma, 10ms spikes with probability spikeRate per second
+ * and lost pulses with probability dropoutRate. The gap of a lost pulse
+ * looks like a minute mark.
+ */
+Fix simulate(std::mt19937& rng, double sigmaMs, double spikeRate, double dropoutRate) {
+  std::normal_distribution<double> jitter(0, sigmaMs * 1000);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  // A random minute between 2025 and 2030, the first mark within 1 minute.
+  const time_t utc = 1735689600 + 60 * static_cast<time_t>(uniform(rng) * 6 * 365 * 1440);
+  const uint64_t firstMarkUs = 1000000 + static_cast<uint64_t>(uniform(rng) * 59e6);
+  gExpected = Expected{utc, static_cast<uint32_t>(firstMarkUs / 1000)};
+  gFix = Fix();
+
+  ArduinoHost::reset();
+  Accumulator accumulator;
+  Receiver receiver;
+  receiver.attachAccumulator(accumulator);
+  receiver.begin();
+
+  std::vector<bench::Edge> edges;
+  for (int k = -1; k < static_cast<int>(MAX_MINUTES); k++) {
+    // Shifted by one minute, since the first minute begins before boot.
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, frameAt(utc + 60 * (k + 1)), firstMarkUs + (k + 1) * 60000000ULL);
+    for (size_t i = 0; i < minute.size(); i += 2) {
+      const int64_t fall = static_cast<int64_t>(minute[i].us + jitter(rng)) - static_cast<int64_t>(60000000);
+      const int64_t rise = std::max<int64_t>(fall + 1000, static_cast<int64_t>(minute[i + 1].us + jitter(rng)) - 60000000LL);
+      if (fall < 1000 || (dropoutRate > 0 && uniform(rng) < dropoutRate)) {
+        continue;
+      }
+      edges.push_back(bench::Edge{static_cast<uint64_t>(fall), LOW});
+      edges.push_back(bench::Edge{static_cast<uint64_t>(rise), HIGH});
+      if (uniform(rng) < spikeRate) {
+        const uint64_t spike = static_cast<uint64_t>(rise) + 300000 + static_cast<uint64_t>(uniform(rng) * 400000);
+        edges.push_back(bench::Edge{spike, LOW});
+        edges.push_back(bench::Edge{spike + 10000, HIGH});
+      }
+    }
+  }
+  std::stable_sort(edges.begin(), edges.end(),
+      [](const bench::Edge& a, const bench::Edge& b) {return a.us < b.us;});
+  bench::replay(edges, PIN);
+  return gFix;
+}
+
+} // anonymous namespace
+
+int main() {
+  const unsigned encoderFailures = verifyEncoder();
+  const unsigned dstFailures = verifyDstChange();
+  const unsigned dropoutFailures = verifyDropouts();
+  if (encoderFailures || dstFailures || dropoutFailures) {
+    printf("error: %u encoder, %u CET/CEST prediction and %u dropout mismatches\n",
+        encoderFailures, dstFailures, dropoutFailures);
+    return EXIT_FAILURE;
+  }
+
+  static constexpr unsigned TRIALS = 40;
+  // Median minutes from boot to the first correct frame, in brackets
+  // the trials without fix within MAX_MINUTES and the wrong frames.
+  printf("%-7s %-7s %-8s %24s %24s\n", "sigma", "spikes", "dropouts", "receiver", "accumulator");
+  struct {double sigmaMs; double spikeRate; double dropoutRate;} const cases[] = {
+      {0, 0, 0}, {15, 0, 0}, {20, 0, 0}, {25, 0, 0}, {30, 0, 0}, {5, 0.02, 0}, {20, 0.02, 0},
+      {5, 0, 0.02}, {20, 0, 0.02}};
+  std::mt19937 rng(11);
+  for (const auto& c : cases) {
+    std::vector<int> rx, acc;
+    unsigned rxNone = 0, accNone = 0, rxWrong = 0, accWrong = 0;
+    for (unsigned t = 0; t < TRIALS; t++) {
+      const Fix fix = simulate(rng, c.sigmaMs, c.spikeRate, c.dropoutRate);
+      rx.push_back(fix.receiver < 0 ? 1000 : fix.receiver);
+      acc.push_back(fix.accumulator < 0 ? 1000 : fix.accumulator);
+      rxNone += fix.receiver < 0;
+      accNone += fix.accumulator < 0;
+      rxWrong += fix.receiverWrong;
+      accWrong += fix.accumulatorWrong;
+    }
+    std::sort(rx.begin(), rx.end());
+    std::sort(acc.begin(), acc.end());
+    printf("%4.0fms %5.0f%% %7.0f%% %8d min (%2u, %3u wrong) %8d min (%2u, %3u wrong)\n",
+        c.sigmaMs, c.spikeRate * 100, c.dropoutRate * 100, rx[TRIALS / 2], rxNone, rxWrong,
+        acc[TRIALS / 2], accNone, accWrong);
+    // Without noise the accumulator must lock after two confirming minutes.
+    if (c.sigmaMs == 0 && c.spikeRate == 0 && (acc[TRIALS - 1] > 5 || accWrong)) {
+      printf("error: accumulator too slow without noise\n");
+      return EXIT_FAILURE;
+    }
+    // Lost pulses must neither deliver a frame early nor twice.
+    if (c.sigmaMs <= 5 && c.dropoutRate > 0 && accWrong) {
+      printf("error: accumulator delivered frames at dropouts\n");
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host benchmark of the batch frame conversion against the scalar loop
+ * over dcf77frame2time() that consumers use today.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t FRAMES = 4096;
+constexpr int REPEAT = 64;
+
+/** A random frame carrying a local time between 2000 and 2099. */
+uint64_t randomFrame(::time_t& utc) {
+  const bool cest = rand() & 1;
+  const ::time_t first = 946684800;   // 2000-01-01 00:00:00
+  const ::time_t last = 4102444799;   // 2099-12-31 23:59:59
+  const ::time_t local = first + static_cast<::time_t>(
+      (static_cast<uint64_t>(rand()) << 16 ^ rand()) % (last - first)) / 60 * 60;
+  struct tm t;
+  gmtime_r(&local, &t);
+  utc = local - (cest ? 7200 : 3600);
+  return bench::encodeFrame(t.tm_year - 100, t.tm_mon + 1, t.tm_mday,
+      t.tm_wday == 0 ? 7 : t.tm_wday, t.tm_hour, t.tm_min, cest);
+}
+
+} // anonymous namespace
+
+int main() {
+  srand(1);
+  std::vector<uint64_t> frames(FRAMES);
+  std::vector< ::time_t> expectedUtc(FRAMES);
+  for (size_t i = 0; i < FRAMES; i++) {
+    frames[i] = randomFrame(expectedUtc[i]);
+  }
+
+  // Verify the batch results against the scalar conversion and libc.
+  std::vector<DCF77::time_t> utc(FRAMES);
+  std::vector<uint8_t> min(FRAMES), hour(FRAMES), mday(FRAMES), mon(FRAMES),
+      year(FRAMES), wday(FRAMES), isdst(FRAMES);
+  DCF77rxbase::DCF77frameFields fields;
+  fields.tm_min = min.data();
+  fields.tm_hour = hour.data();
+  fields.tm_mday = mday.data();
+  fields.tm_mon = mon.data();
+  fields.tm_year = year.data();
+  fields.tm_wday = wday.data();
+  fields.tm_isdst = isdst.data();
+  DCF77rxbase::dcf77frames2fields(fields, frames.data(), FRAMES);
+  DCF77rxbase::dcf77frames2utc(utc.data(), frames.data(), FRAMES);
+  for (size_t i = 0; i < FRAMES; i++) {
+    DCF77::tm tm;
+    DCF77rxbase::dcf77frame2time(tm, frames[i]);
+    if (tm.tm_min != min[i] || tm.tm_hour != hour[i] || tm.tm_mday != mday[i]
+        || tm.tm_mon != mon[i] || tm.tm_year != year[i] || tm.tm_wday != wday[i]
+        || tm.tm_isdst != isdst[i] || utc[i] != expectedUtc[i]) {
+      printf("error: batch conversion of frame 0x%016llx differs\n",
+          static_cast<unsigned long long>(frames[i]));
+      return EXIT_FAILURE;
+    }
+  }
+
+  const size_t ops = FRAMES * REPEAT;
+  const double nsScalarFields = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      for (size_t i = 0; i < FRAMES; i++) {
+        DCF77::tm tm;
+        DCF77rxbase::dcf77frame2time(tm, frames[i]);
+        min[i] = tm.tm_min; hour[i] = tm.tm_hour; mday[i] = tm.tm_mday;
+        mon[i] = tm.tm_mon; year[i] = tm.tm_year; wday[i] = tm.tm_wday;
+        isdst[i] = tm.tm_isdst;
+      }
+      bench::doNotOptimize(min[0]);
+    }
+  });
+  const double nsBatchFields = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      DCF77rxbase::dcf77frames2fields(fields, frames.data(), FRAMES);
+      bench::doNotOptimize(min[0]);
+    }
+  });
+  const double nsScalarUtc = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      for (size_t i = 0; i < FRAMES; i++) {
+        DCF77::tm tm;
+        DCF77rxbase::dcf77frame2time(tm, frames[i]);
+        utc[i] = DCF77::tm_to_timestamp(tm) - (tm.tm_isdst ? 7200 : 3600);
+      }
+      bench::doNotOptimize(utc[0]);
+    }
+  });
+  const double nsBatchUtc = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      DCF77rxbase::dcf77frames2utc(utc.data(), frames.data(), FRAMES);
+      bench::doNotOptimize(utc[0]);
+    }
+  });
+
+  bench::report("scalar dcf77frame2time -> fields", 1e3 / nsScalarFields, "Mframes/s");
+  bench::report("dcf77frames2fields", 1e3 / nsBatchFields, "Mframes/s");
+  bench::report("scalar dcf77frame2time -> UTC", 1e3 / nsScalarUtc, "Mframes/s");
+  bench::report("dcf77frames2utc", 1e3 / nsBatchUtc, "Mframes/s");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host verification and benchmark of the division free calendar kernels.
+ *
+ * timestamp_to_tm() is compared against gmtime_r() for the first and the
+ * last second of every day from 1970-01-01 to 2106-02-07, and for random
+ * seconds in between. tm_to_timestamp() is compared against timegm() for
+ * the same days up to 2199-12-31. The kernels themselves are checked to
+ * round trip over their full range. Afterwards both conversions are timed
+ * against the former implementation, which used divisions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "internal/DCF77calendar.h"
+#include "bench.h"
+
+namespace {
+
+/* The former implementation, kept for reference. */
+namespace legacy {
+
+constexpr long EPOCH_ADJUSTMENT_DAYS = 719468L;
+constexpr int ADJUSTED_EPOCH_WDAY = 3;
+constexpr long DAYS_PER_ERA = 146097L;
+constexpr long DAYS_PER_CENTURY = 36524L;
+constexpr int DAYS_PER_4_YEARS = 3 * 365 + 366;
+constexpr int SECSPERMIN = 60;
+constexpr long SECSPERHOUR = 3600;
+constexpr long SECSPERDAY = 86400;
+
+const int month_yday[2][12] = {
+  {-1, 30, 58, 89, 119, 150, 180, 211, 242, 272, 303, 333},
+  {-1, 30, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334},
+};
+
+inline int isLeapYear(uint16_t year) {
+  return not (year % 4) && ((year % 100) || not (year % 400));
+}
+
+inline int leapYearsSince1970(const int year) {
+  return (year - 1968) / 4 - (year - 1900) / 100 + (year - 1600) / 400;
+}
+
+__attribute__((noinline))
+DCF77::time_t tm_to_timestamp(const DCF77::tm& tm) {
+  using time_t = DCF77::time_t;
+  const int year = tm.tm_year + DCF77::TM_YEAR_BASE;
+  const bool leapYear = isLeapYear(year);
+  const time_t leapYearsBeforeThisYear = leapYearsSince1970(year) - leapYear;
+  const time_t yearOffset = year - 1970;
+  const int yday = month_yday[leapYear][tm.tm_mon] + tm.tm_mday;
+  return tm.tm_sec + (tm.tm_min + (tm.tm_hour + (yday + leapYearsBeforeThisYear + yearOffset * 365) * 24) * 60) * 60;
+}
+
+__attribute__((noinline))
+void timestamp_to_tm(DCF77::tm& tm, const DCF77::time_t timestamp, const int isdst) {
+  long days = timestamp / SECSPERDAY + EPOCH_ADJUSTMENT_DAYS;
+  long remain = timestamp % SECSPERDAY;
+  if (remain < 0) {
+    remain += SECSPERDAY;
+    --days;
+  }
+  tm.tm_wday = (ADJUSTED_EPOCH_WDAY + 7 + days) % 7;
+  tm.tm_hour = remain / SECSPERHOUR;
+  remain %= SECSPERHOUR;
+  tm.tm_min = remain / SECSPERMIN;
+  tm.tm_sec = remain % SECSPERMIN;
+
+  const int era = (days >= 0 ? days : days - (DAYS_PER_ERA - 1)) / DAYS_PER_ERA;
+  const unsigned long eraday = days - era * DAYS_PER_ERA;
+  const unsigned erayear = (eraday - eraday / (DAYS_PER_4_YEARS - 1) + eraday / DAYS_PER_CENTURY -
+      eraday / (DAYS_PER_ERA - 1)) / 365;
+  const unsigned yearday = eraday - (365 * erayear + erayear / 4 - erayear / 100);
+  const unsigned m = (5 * yearday + 2) / 153;
+  const unsigned month = m < 10 ? m + 2 : m - 10;
+  tm.tm_mday = yearday - (153 * m + 2) / 5 + 1;
+  tm.tm_mon = month;
+  tm.tm_year = -DCF77::TM_YEAR_BASE + erayear + era * 400 + (month <= 1);
+  tm.tm_isdst = isdst;
+}
+
+} // namespace legacy
+
+__attribute__((noinline))
+DCF77::time_t kernel_tm_to_timestamp(const DCF77::tm& tm) {
+  return DCF77::tm_to_timestamp(tm);
+}
+
+__attribute__((noinline))
+void kernel_timestamp_to_tm(DCF77::tm& tm, const DCF77::time_t timestamp, const int isdst) {
+  DCF77::timestamp_to_tm(tm, timestamp, isdst);
+}
+
+bool sameTm(const DCF77::tm& a, const struct tm& b) {
+  return a.tm_sec == b.tm_sec && a.tm_min == b.tm_min && a.tm_hour == b.tm_hour
+      && a.tm_mday == b.tm_mday && a.tm_mon == b.tm_mon && a.tm_year == b.tm_year
+      && a.tm_wday == b.tm_wday && a.tm_yday == b.tm_yday;
+}
+
+unsigned checkTimestamp(const time_t ts) {
+  struct tm expected;
+  gmtime_r(&ts, &expected);
+  DCF77::tm actual;
+  memset(&actual, 0, sizeof(actual));
+  DCF77::timestamp_to_tm(actual, ts, 0);
+  if (not sameTm(actual, expected)) {
+    fprintf(stderr, "timestamp_to_tm(%lld) mismatch: %04d-%02d-%02d %02d:%02d:%02d wday %d yday %d\n",
+        static_cast<long long>(ts), actual.tm_year + 1900, actual.tm_mon + 1, actual.tm_mday,
+        actual.tm_hour, actual.tm_min, actual.tm_sec, actual.tm_wday, actual.tm_yday);
+    return 1;
+  }
+  const time_t back = DCF77::tm_to_timestamp(actual);
+  if (back != ts || back != timegm(&expected)) {
+    fprintf(stderr, "tm_to_timestamp(%lld) mismatch: %lld\n", static_cast<long long>(ts),
+        static_cast<long long>(back));
+    return 1;
+  }
+  return 0;
+}
+
+unsigned verify() {
+  unsigned failures = 0;
+
+  /* Kernels: round trip over the full range. */
+  for (uint32_t days = 0; days <= DCF77calendar::MAX_DAYS; days++) {
+    const DCF77calendar::civil_t c = DCF77calendar::civil_from_days(days);
+    if (DCF77calendar::days_from_civil(c.year, c.month, c.mday) != days) {
+      fprintf(stderr, "calendar kernel round trip mismatch at day %u\n", days);
+      failures++;
+    }
+  }
+
+  /* First and last second of every day within 32 bit time stamps. */
+  const uint32_t lastDay = UINT32_MAX / DCF77calendar::SECS_PER_DAY;
+  for (uint32_t day = 0; day <= lastDay; day++) {
+    const time_t start = static_cast<time_t>(day) * DCF77calendar::SECS_PER_DAY;
+    failures += checkTimestamp(start);
+    const time_t end = start + DCF77calendar::SECS_PER_DAY - 1;
+    if (end <= static_cast<time_t>(UINT32_MAX)) {
+      failures += checkTimestamp(end);
+    }
+  }
+  failures += checkTimestamp(static_cast<time_t>(UINT32_MAX));
+
+  /* Random seconds. */
+  srand(77);
+  for (int i = 0; i < 2000000; i++) {
+    const uint32_t ts = (static_cast<uint32_t>(rand()) << 16) ^ static_cast<uint32_t>(rand());
+    failures += checkTimestamp(ts);
+  }
+
+  /* tm_to_timestamp() beyond 32 bit time stamps, up to the kernel limit. */
+  for (int year = 2106; year <= 2199; year++) {
+    for (int mon = 0; mon < 12; mon++) {
+      for (int mday = 1; mday <= 28; mday += 9) {
+        struct tm t;
+        memset(&t, 0, sizeof(t));
+        t.tm_year = year - 1900;
+        t.tm_mon = mon;
+        t.tm_mday = mday;
+        t.tm_hour = 23;
+        t.tm_min = 59;
+        t.tm_sec = 59;
+        DCF77::tm d = t;
+        if (DCF77::tm_to_timestamp(d) != timegm(&t)) {
+          fprintf(stderr, "tm_to_timestamp mismatch at %04d-%02d-%02d\n", year, mon + 1, mday);
+          failures++;
+        }
+      }
+    }
+  }
+
+  /* The generic fallback outside of the kernel range. */
+  failures += checkTimestamp(static_cast<time_t>(UINT32_MAX) + 1);
+  failures += checkTimestamp(static_cast<time_t>(7258118400LL));  /* 2200-01-01 */
+  return failures;
+}
+
+} // anonymous namespace
+
+int main() {
+  const unsigned failures = verify();
+  if (failures) {
+    fprintf(stderr, "%u calendar mismatches\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("calendar verification: all days 1970-01-01 to 2106-02-07 match gmtime_r/timegm\n");
+
+  /* Time stamps spread over the whole 32 bit range. */
+  static constexpr size_t N = 4096;
+  std::vector<DCF77::time_t> stamps(N);
+  std::vector<DCF77::tm> tms(N);
+  srand(1);
+  for (size_t i = 0; i < N; i++) {
+    stamps[i] = (static_cast<uint32_t>(rand()) << 16) ^ static_cast<uint32_t>(rand());
+    DCF77::timestamp_to_tm(tms[i], stamps[i], 0);
+  }
+
+  DCF77::tm tm;
+  const double legacyToTm = bench::nsPerOp(N, [&]() {
+    for (size_t i = 0; i < N; i++) {
+      legacy::timestamp_to_tm(tm, stamps[i], 0);
+      bench::doNotOptimize(tm);
+    }
+  });
+  const double kernelToTm = bench::nsPerOp(N, [&]() {
+    for (size_t i = 0; i < N; i++) {
+      kernel_timestamp_to_tm(tm, stamps[i], 0);
+      bench::doNotOptimize(tm);
+    }
+  });
+  const double legacyToTs = bench::nsPerOp(N, [&]() {
+    for (size_t i = 0; i < N; i++) {
+      DCF77::time_t ts = legacy::tm_to_timestamp(tms[i]);
+      bench::doNotOptimize(ts);
+    }
+  });
+  const double kernelToTs = bench::nsPerOp(N, [&]() {
+    for (size_t i = 0; i < N; i++) {
+      DCF77::time_t ts = kernel_tm_to_timestamp(tms[i]);
+      bench::doNotOptimize(ts);
+    }
+  });
+
+  bench::report("timestamp_to_tm (former, divisions)", legacyToTm, "ns/conversion");
+  bench::report("timestamp_to_tm (calendar kernels)", kernelToTm, "ns/conversion");
+  bench::report("tm_to_timestamp (former, divisions)", legacyToTs, "ns/conversion");
+  bench::report("tm_to_timestamp (calendar kernels)", kernelToTs, "ns/conversion");
+  bench::report("timestamp_to_tm speedup", legacyToTm / kernelToTm, "x");
+  bench::report("tm_to_timestamp speedup", legacyToTs / kernelToTs, "x");
+  return EXIT_SUCCESS;
+}
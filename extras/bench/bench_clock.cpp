@@ -0,0 +1,118 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host benchmark of DCF77wallclock::getTime() against the approach of the
+ * former DCF77Clock example, which converted the last frame on every call.
+ */
+
+#include <stdlib.h>
+
+#include "DCF77rxtm.h"
+#include "DCF77wallclock.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t CALLS = 2000000;
+
+/** The former DCF77Clock::getTime(). */
+bool exampleGetTime(uint64_t dcf77frame, uint32_t systickAtFrame, DCF77::tm& tm, unsigned* millisec) {
+  noInterrupts();
+  const uint32_t millisSinceLastFrame = millis() - systickAtFrame;
+  interrupts();
+  const uint32_t secSinceLastFrame = millisSinceLastFrame / 1000;
+  DCF77rxbase::dcf77frame2time(tm, dcf77frame);
+  const DCF77::time_t timestamp = DCF77::tm_to_timestamp(tm);
+  DCF77::timestamp_to_tm(tm, timestamp + secSinceLastFrame, tm.tm_isdst);
+  if (millisec != nullptr) {
+    *millisec = millisSinceLastFrame % 1000;
+  }
+  return true;
+}
+
+bool sameTime(const DCF77::tm& a, const DCF77::tm& b) {
+  return a.tm_sec == b.tm_sec && a.tm_min == b.tm_min && a.tm_hour == b.tm_hour
+      && a.tm_mday == b.tm_mday && a.tm_mon == b.tm_mon && a.tm_year == b.tm_year
+      && a.tm_wday == b.tm_wday && a.tm_isdst == b.tm_isdst;
+}
+
+} // anonymous namespace
+
+int main() {
+  // 2025-02-23 23:58 CET, Sunday. Crosses midnight after 2 minutes.
+  const uint64_t frame = bench::encodeFrame(25, 2, 23, 7, 23, 58, false);
+  const uint32_t systickAtFrame = 5000;
+  ArduinoHost::reset();
+  ArduinoHost::setMicros(systickAtFrame * 1000ULL);
+
+  DCF77wallclock wallclock;
+  wallclock.update(frame, systickAtFrame);
+
+  // Both approaches must agree, whatever the step between the calls.
+  srand(1);
+  for (size_t i = 0; i < 200000; i++) {
+    ArduinoHost::advanceMicros(1000ULL * (rand() % 4 ? rand() % 1500 : rand() % 100000));
+    DCF77::tm expected, actual;
+    unsigned expectedMillis, actualMillis;
+    exampleGetTime(frame, systickAtFrame, expected, &expectedMillis);
+    if (not wallclock.getTime(actual, &actualMillis) || not sameTime(expected, actual)
+        || expectedMillis != actualMillis) {
+      printf("error: DCF77wallclock differs at millis()=%u\n", static_cast<unsigned>(millis()));
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Calls from a loop that runs once per millisecond and once per second.
+  // Every round restarts close to the frame to stay within the systick
+  // range.
+  const uint64_t steps[] = {1, 1000};
+  for (const uint64_t step : steps) {
+    const double nsExample = bench::nsPerOp(CALLS, [&]() {
+      ArduinoHost::setMicros(systickAtFrame * 1000ULL);
+      DCF77::tm tm;
+      unsigned ms;
+      for (size_t i = 0; i < CALLS; i++) {
+        ArduinoHost::advanceMicros(step * 1000);
+        exampleGetTime(frame, systickAtFrame, tm, &ms);
+        bench::doNotOptimize(tm);
+      }
+    });
+    const double nsWallclock = bench::nsPerOp(CALLS, [&]() {
+      ArduinoHost::setMicros(systickAtFrame * 1000ULL);
+      wallclock.update(frame, systickAtFrame);
+      DCF77::tm tm;
+      unsigned ms;
+      for (size_t i = 0; i < CALLS; i++) {
+        ArduinoHost::advanceMicros(step * 1000);
+        wallclock.getTime(tm, &ms);
+        bench::doNotOptimize(tm);
+      }
+    });
+    printf("calls every %lu ms:\n", static_cast<unsigned long>(step));
+    bench::report("  example getTime (3 conversions)", 1e3 / nsExample, "Mcalls/s");
+    bench::report("  DCF77wallclock::getTime", 1e3 / nsWallclock, "Mcalls/s");
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host benchmark of the decoder hot paths: pulse processing in the pin
+ * interrupt, frame to time structure decoding and time stamp conversion.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "internal/DCF77frame.h"
+#include "bench.h"
+
+namespace {
+
+constexpr int PIN = 2;
+constexpr int POLLED_PIN = 3;
+constexpr unsigned MINUTES = 60;
+
+template<int RECEIVER_PIN> class BenchReceiver : public DCF77rx<RECEIVER_PIN> {
+public:
+  uint32_t mFrameCount = 0;
+  uint64_t mLastFrame = 0;
+
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    (void)systick;
+    mFrameCount++;
+    mLastFrame = dcf77frame;
+  }
+};
+
+BenchReceiver<PIN> receiver;
+BenchReceiver<POLLED_PIN> polledReceiver;
+
+uint64_t randomFrame() {
+  const unsigned year = rand() % 100;
+  const unsigned month = 1 + rand() % 12;
+  const unsigned mday = 1 + rand() % 28;
+  const unsigned wday = 1 + rand() % 7;
+  const unsigned hour = rand() % 24;
+  const unsigned minute = rand() % 60;
+  return bench::encodeFrame(year, month, mday, wday, hour, minute, rand() & 1);
+}
+
+} // anonymous namespace
+
+int main() {
+  srand(1);
+  ArduinoHost::reset();
+  receiver.begin();
+  polledReceiver.begin(DCF77rxbase::DECODE_IN_POLL);
+
+  // A single flipped bit in the minute, hour or date section must be
+  // rejected by the parity check. Only the uncorrupted minute may be
+  // delivered.
+  uint64_t offset = 0;
+  {
+    const uint64_t frame = bench::encodeFrame(25, 2, 23, 7, 15, 10, false);
+    const uint64_t flipped[] = {
+        frame ^ static_cast<uint64_t>(1) << 22, frame ^ static_cast<uint64_t>(1) << 30,
+        frame, frame ^ static_cast<uint64_t>(1) << 40};
+    std::vector<bench::Edge> minutes;
+    for (const uint64_t f : flipped) {
+      bench::appendMinute(minutes, f, offset);
+      offset += 60000000ULL;
+    }
+    bench::replay(minutes, PIN);
+    if (receiver.mFrameCount != 1 || receiver.mLastFrame != frame) {
+      printf("error: parity check failed\n");
+      return EXIT_FAILURE;
+    }
+    receiver.mFrameCount = 0;
+  }
+
+  // A minute with an announced leap second has a 60th pulse, which is
+  // 0. Without the announcement the surplus pulse is a spike, and that
+  // minute must be rejected. It is concluded by the first replay below.
+  {
+    const uint64_t a2 = static_cast<uint64_t>(1) << DCF77frame::A2::pos;
+    // The leap second 2016-12-31 23:59:60 UTC ends the minute 00:59 CET.
+    const uint64_t frame = bench::encodeFrame(17, 1, 1, 7, 1, 0, false) | a2;
+    std::vector<bench::Edge> minutes;
+    for (const uint64_t f : {frame, frame & ~a2}) {
+      bench::appendMinute(minutes, f, offset);
+      minutes.push_back(bench::Edge{offset + 59000000ULL, LOW});
+      minutes.push_back(bench::Edge{offset + 59100000ULL, HIGH});
+      offset += 61000000ULL;
+    }
+    bench::replay(minutes, PIN);
+    if (receiver.mFrameCount != 1 || receiver.mLastFrame != frame) {
+      printf("error: leap second minute not decoded\n");
+      return EXIT_FAILURE;
+    }
+    receiver.mFrameCount = 0;
+  }
+
+  // Pulse processing through the pin interrupt.
+  std::vector<bench::Edge> edges;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    const uint64_t frame = bench::encodeFrame(25, 2, 23, 7, 15, m, false);
+    bench::appendMinute(edges, frame, m * 60000000ULL);
+  }
+  uint32_t replays = 0;
+  const double nsPerPulse = bench::nsPerOp(edges.size(), [&]() {
+    bench::replay(edges, PIN, offset);
+    offset += MINUTES * 60000000ULL;
+    replays++;
+  });
+  // The last minute is concluded by the sync mark of the next replay.
+  // The first replay concludes the corrupted minute from above.
+  if (receiver.mFrameCount != replays * MINUTES - 1) {
+    printf("error: %u frames decoded, expected %u\n",
+        static_cast<unsigned>(receiver.mFrameCount), static_cast<unsigned>(replays * MINUTES - 1));
+    return EXIT_FAILURE;
+  }
+
+  // Pulses queued by the pin interrupt and decoded by poll(). The
+  // interrupt handler time is measured separately from poll().
+  offset = 0;
+  replays = 0;
+  uint64_t isrNs = 0;
+  const double nsPerPolledPulse = bench::nsPerOp(edges.size(), [&]() {
+    for (size_t i = 0; i < edges.size(); i++) {
+      ArduinoHost::setMicros(edges[i].us + offset);
+      const uint64_t start = bench::nowNs();
+      ArduinoHost::setPinLevel(POLLED_PIN, edges[i].level);
+      isrNs += bench::nowNs() - start;
+      polledReceiver.poll();
+    }
+    offset += MINUTES * 60000000ULL;
+    replays++;
+  });
+  if (polledReceiver.mFrameCount != replays * MINUTES - 1 || polledReceiver.pulseOverflowCount()) {
+    printf("error: %u frames decoded in poll(), expected %u\n",
+        static_cast<unsigned>(polledReceiver.mFrameCount), static_cast<unsigned>(replays * MINUTES - 1));
+    return EXIT_FAILURE;
+  }
+  const double nsPerQueuedPulse = static_cast<double>(isrNs) / (replays * edges.size());
+
+  // Frame to time structure decoding.
+  std::vector<uint64_t> frames(1024);
+  for (uint64_t& f : frames) {
+    f = randomFrame();
+  }
+  const double nsPerFrame = bench::nsPerOp(frames.size() * 256, [&]() {
+    DCF77::tm tm;
+    for (int r = 0; r < 256; r++) {
+      for (const uint64_t f : frames) {
+        DCF77rxbase::dcf77frame2time(tm, f);
+        bench::doNotOptimize(tm);
+      }
+    }
+  });
+
+  // Time stamp conversion in both directions.
+  std::vector<DCF77::tm> tms(frames.size());
+  std::vector<DCF77::time_t> stamps(frames.size());
+  for (size_t i = 0; i < frames.size(); i++) {
+    DCF77rxbase::dcf77frame2time(tms[i], frames[i]);
+    stamps[i] = DCF77::tm_to_timestamp(tms[i]);
+  }
+  const double nsPerToTimestamp = bench::nsPerOp(tms.size() * 256, [&]() {
+    for (int r = 0; r < 256; r++) {
+      for (const DCF77::tm& tm : tms) {
+        const DCF77::time_t t = DCF77::tm_to_timestamp(tm);
+        bench::doNotOptimize(t);
+      }
+    }
+  });
+  const double nsPerToTm = bench::nsPerOp(stamps.size() * 256, [&]() {
+    DCF77::tm tm;
+    for (int r = 0; r < 256; r++) {
+      for (const DCF77::time_t t : stamps) {
+        DCF77::timestamp_to_tm(tm, t, 0);
+        bench::doNotOptimize(tm);
+      }
+    }
+  });
+
+  bench::report("processPulse (via pin interrupt)", nsPerPulse, "ns/pulse");
+  bench::report("pin interrupt + poll (DECODE_IN_POLL)", nsPerPolledPulse, "ns/pulse");
+  bench::report("pin interrupt only (DECODE_IN_POLL)", nsPerQueuedPulse, "ns/pulse");
+  bench::report("dcf77frame2time", nsPerFrame, "ns/frame");
+  bench::report("tm_to_timestamp", nsPerToTimestamp, "ns/conversion");
+  bench::report("timestamp_to_tm", nsPerToTm, "ns/conversion");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host simulation of the frame yield of a single receiver against three
+ * receivers combined by DCF77combiner. Each receiver sees the same frames
+ * with independent noise on the pulse edges.
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DCF77combiner.h"
+#include "bench.h"
+
+namespace {
+
+constexpr unsigned MINUTES = 600;
+constexpr uint64_t MINUTE_US = 60000000ULL;
+
+/** The frame of minute m. Day 2025-03-01 is a Saturday. */
+uint64_t frameOfMinute(unsigned m) {
+  return bench::encodeFrame(25, 3, 1, 6, m / 60, m % 60, false);
+}
+
+/** Whether a frame concluded at systick is the one sent in the past minute. */
+bool isExpected(uint64_t dcf77frame, uint32_t systick) {
+  const unsigned minute = static_cast<unsigned>((systick + 30000) / 60000) - 1;
+  return dcf77frame == frameOfMinute(minute);
+}
+
+struct Yield {
+  uint32_t frames = 0;
+  uint32_t wrongFrames = 0;
+
+  void count(uint64_t dcf77frame, uint32_t systick) {
+    frames++;
+    wrongFrames += !isExpected(dcf77frame, systick);
+  }
+};
+
+/** A receiver that feeds the combiner and counts its own frames, too. */
+template<int RECEIVER_PIN> class CountingRx : public DCF77rx<RECEIVER_PIN> {
+public:
+  explicit CountingRx(DCF77combiner& combiner) {
+    this->attachCombiner(combiner);
+  }
+  Yield mYield;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mYield.count(dcf77frame, systick);
+  }
+};
+
+class CountingCombiner : public DCF77combiner {
+public:
+  explicit CountingCombiner(VOTING voting) : DCF77combiner(voting) {}
+  Yield mYield;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mYield.count(dcf77frame, systick);
+  }
+};
+
+class FrameCombiner : public DCF77combiner {
+public:
+  std::vector<uint64_t> mFrames;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t) override {
+    mFrames.push_back(dcf77frame);
+  }
+};
+
+/**
+ * The 60 bits of a minute with an announced leap second must pass the
+ * combiner, like they pass a single receiver.
+ */
+bool verifyLeapSecond() {
+  ArduinoHost::reset();
+  FrameCombiner combiner;
+  CountingRx<2> rxA(combiner);
+  CountingRx<3> rxB(combiner);
+  rxA.begin();
+  rxB.begin();
+
+  const uint64_t a2 = static_cast<uint64_t>(1) << DCF77frame::A2::pos;
+  // The leap second 2016-12-31 23:59:60 UTC ends the minute 00:59 CET.
+  const uint64_t leapFrame = bench::encodeFrame(17, 1, 1, 7, 1, 0, false) | a2;
+  std::vector<bench::Edge> edges;
+  bench::appendMinute(edges, bench::encodeFrame(17, 1, 1, 7, 0, 59, false), MINUTE_US);
+  bench::appendMinute(edges, leapFrame, 2 * MINUTE_US);
+  edges.push_back(bench::Edge{2 * MINUTE_US + 59000000, LOW});
+  edges.push_back(bench::Edge{2 * MINUTE_US + 59100000, HIGH});
+  // The mark of the next minute concludes the leap second minute.
+  edges.push_back(bench::Edge{3 * MINUTE_US + 1000000, LOW});
+  edges.push_back(bench::Edge{3 * MINUTE_US + 1100000, HIGH});
+  for (const bench::Edge& e : edges) {
+    ArduinoHost::setMicros(e.us);
+    ArduinoHost::setPinLevel(2, e.level);
+    ArduinoHost::setPinLevel(3, e.level);
+  }
+  return not combiner.mFrames.empty() && combiner.mFrames.back() == leapFrame;
+}
+
+struct PinEdge {
+  uint64_t us;
+  int level;
+  uint8_t pin;
+};
+
+/**
+ * Receive MINUTES minutes on three pins with independent edge noise.
+ * The edge time deviation is normally distributed with sigma. With
+ * probability spikeRate a pulse is hit by a 10ms spike.
+ *
+ * @param[out] single The yield of the first receiver on its own.
+ * @param[out] combined The yield of the combiner.
+ */
+void simulate(double sigmaMs, double spikeRate, DCF77combiner::VOTING voting,
+    Yield& single, Yield& combined) {
+  static constexpr uint8_t PINS[] = {2, 3, 4};
+  std::mt19937 rng(7);
+  std::normal_distribution<double> jitter(0, sigmaMs * 1000);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  ArduinoHost::reset();
+  CountingCombiner combiner(voting);
+  CountingRx<PINS[0]> rxA(combiner);
+  CountingRx<PINS[1]> rxB(combiner);
+  CountingRx<PINS[2]> rxC(combiner);
+  rxA.begin();
+  rxB.begin();
+  rxC.begin();
+
+  std::vector<PinEdge> edges;
+  // Start with minute 1, so that jitter can't produce negative times.
+  for (unsigned m = 1; m <= MINUTES; m++) {
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, frameOfMinute(m), m * MINUTE_US);
+    for (const uint8_t pin : PINS) {
+      for (size_t i = 0; i < minute.size(); i += 2) {
+        const int64_t fall = static_cast<int64_t>(minute[i].us + jitter(rng));
+        const int64_t rise = std::max(fall + 1000, static_cast<int64_t>(minute[i + 1].us + jitter(rng)));
+        edges.push_back(PinEdge{static_cast<uint64_t>(fall), LOW, pin});
+        edges.push_back(PinEdge{static_cast<uint64_t>(rise), HIGH, pin});
+        if (uniform(rng) < spikeRate) {
+          const uint64_t spike = static_cast<uint64_t>(rise) + 300000 + static_cast<uint64_t>(uniform(rng) * 400000);
+          edges.push_back(PinEdge{spike, LOW, pin});
+          edges.push_back(PinEdge{spike + 10000, HIGH, pin});
+        }
+      }
+    }
+  }
+  std::stable_sort(edges.begin(), edges.end(),
+      [](const PinEdge& a, const PinEdge& b) {return a.us < b.us;});
+  for (const PinEdge& e : edges) {
+    ArduinoHost::setMicros(e.us);
+    ArduinoHost::setPinLevel(e.pin, e.level);
+  }
+
+  single = rxA.mYield;
+  combined = combiner.mYield;
+}
+
+} // anonymous namespace
+
+int main() {
+  if (not verifyLeapSecond()) {
+    printf("error: combiner dropped the leap second minute\n");
+    return EXIT_FAILURE;
+  }
+
+  // Frames per hour, in brackets the frames with undetected bit errors,
+  // which passed the parity check.
+  printf("%-9s %-7s %18s %18s %18s\n", "sigma", "spikes",
+      "single", "majority", "weighted");
+  struct {double sigmaMs; double spikeRate;} const cases[] = {
+      {5, 0}, {15, 0}, {20, 0}, {25, 0}, {5, 0.01}, {5, 0.02}, {15, 0.01}};
+  for (const auto& c : cases) {
+    Yield single, majority, weighted;
+    simulate(c.sigmaMs, c.spikeRate, DCF77combiner::MAJORITY, single, majority);
+    simulate(c.sigmaMs, c.spikeRate, DCF77combiner::CONFIDENCE_WEIGHTED, single, weighted);
+    printf("%5.0fms %6.0f%% %9.1f fr/h (%2u) %9.1f fr/h (%2u) %9.1f fr/h (%2u)\n",
+        c.sigmaMs, c.spikeRate * 100,
+        single.frames * 60.0 / MINUTES, static_cast<unsigned>(single.wrongFrames),
+        majority.frames * 60.0 / MINUTES, static_cast<unsigned>(majority.wrongFrames),
+        weighted.frames * 60.0 / MINUTES, static_cast<unsigned>(weighted.wrongFrames));
+    // Without noise every frame must get through.
+    if (c.sigmaMs <= 5 && c.spikeRate == 0 && weighted.frames < MINUTES - 2) {
+      printf("error: combiner lost frames without noise\n");
+      return EXIT_FAILURE;
+    }
+    // Combining must never let more bit errors through than one receiver.
+    if (majority.wrongFrames > single.wrongFrames || weighted.wrongFrames > single.wrongFrames) {
+      printf("error: combiner delivered more wrong frames than a single receiver\n");
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host simulation of the latency from power up to a usable time with
+ * partialTime() compared to the first complete frame. The receiver is
+ * powered up at a random point of the minute and queried every 50ms.
+ * Every field flagged as valid is checked against the transmitted time.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "bench.h"
+
+namespace {
+
+constexpr uint8_t PIN = 3;
+constexpr uint32_t QUERY_MS = 50;
+constexpr unsigned MINUTES = 3;
+
+struct Boot {
+  /* Local time at the first minute mark and the time of that mark. */
+  time_t mLocalAtMark;
+  uint32_t mFirstMarkMs;
+  bool mCest;
+  uint32_t mFrameMs;
+};
+
+Boot gBoot;
+
+uint64_t frameAt(time_t local, bool cest) {
+  struct tm t;
+  gmtime_r(&local, &t);
+  return bench::encodeFrame(t.tm_year - 100, t.tm_mon + 1, t.tm_mday,
+      t.tm_wday == 0 ? 7 : t.tm_wday, t.tm_hour, t.tm_min, cest);
+}
+
+class Receiver : public DCF77rx<PIN> {
+  void onDCF77FrameReceived(const uint64_t, const uint32_t systick) override {
+    if (gBoot.mFrameMs == 0) {
+      gBoot.mFrameMs = systick;
+    }
+  }
+};
+
+struct Latency {
+  uint32_t second = 0;
+  uint32_t time = 0;
+  uint32_t date = 0;
+  uint32_t frame = 0;
+};
+
+/** Check the fields flagged valid. @return false on mismatch. */
+bool check(const DCF77::tm& t, uint32_t systick, uint8_t valid) {
+  const int32_t sinceMark = static_cast<int32_t>(systick - gBoot.mFirstMarkMs);
+  const time_t local = gBoot.mLocalAtMark + (sinceMark + 500) / 1000;
+  struct tm e;
+  gmtime_r(&local, &e);
+  bool ok = t.tm_sec == e.tm_sec;
+  if (valid & DCF77rxbase::PARTIAL_TIME) {
+    ok = ok && t.tm_min == e.tm_min && t.tm_hour == e.tm_hour && t.tm_isdst == gBoot.mCest;
+  }
+  if (valid & DCF77rxbase::PARTIAL_DATE) {
+    ok = ok && t.tm_mday == e.tm_mday && t.tm_mon == e.tm_mon && t.tm_year == e.tm_year
+        && t.tm_wday == e.tm_wday;
+  }
+  return ok;
+}
+
+bool simulate(std::mt19937& rng, Latency& latency) {
+  std::uniform_real_distribution<double> uniform(0, 1);
+  const time_t local = 1735689600 + 60 * static_cast<time_t>(uniform(rng) * 6 * 365 * 1440);
+  const uint64_t firstMarkUs = 1000 + static_cast<uint64_t>(uniform(rng) * 60e6);
+  gBoot = Boot{local, static_cast<uint32_t>(firstMarkUs / 1000), uniform(rng) < 0.5, 0};
+
+  ArduinoHost::reset();
+  Receiver rx;
+  rx.begin();
+
+  // The minute before the first mark is received partially.
+  std::vector<bench::Edge> edges;
+  for (unsigned k = 0; k <= MINUTES; k++) {
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, frameAt(local + 60 * k, gBoot.mCest), firstMarkUs + k * 60000000ULL);
+    for (const bench::Edge& e : minute) {
+      if (e.us >= 60000000ULL + 1000) {
+        edges.push_back(bench::Edge{e.us - 60000000ULL, e.level});
+      }
+    }
+  }
+
+  latency = Latency();
+  size_t next = 0;
+  for (uint64_t us = 0; next < edges.size(); us += QUERY_MS * 1000) {
+    for (; next < edges.size() && edges[next].us <= us; next++) {
+      ArduinoHost::setMicros(edges[next].us);
+      ArduinoHost::setPinLevel(PIN, edges[next].level);
+    }
+    ArduinoHost::setMicros(us);
+
+    DCF77::tm t;
+    uint32_t systick;
+    const uint8_t valid = rx.partialTime(t, systick);
+    if (valid && not check(t, systick, valid)) {
+      printf("error: wrong partial time %02d:%02d:%02d (flags %u) at %llu ms\n",
+          t.tm_hour, t.tm_min, t.tm_sec, valid, static_cast<unsigned long long>(us / 1000));
+      return false;
+    }
+    const uint32_t ms = static_cast<uint32_t>(us / 1000);
+    if ((valid & DCF77rxbase::PARTIAL_SECOND) && latency.second == 0) {
+      latency.second = ms;
+    }
+    if ((valid & DCF77rxbase::PARTIAL_TIME) && latency.time == 0) {
+      latency.time = ms;
+    }
+    if ((valid & DCF77rxbase::PARTIAL_DATE) && latency.date == 0) {
+      latency.date = ms;
+    }
+  }
+  latency.frame = gBoot.mFrameMs;
+  return true;
+}
+
+} // anonymous namespace
+
+int main() {
+  static constexpr unsigned BOOTS = 500;
+  std::mt19937 rng(5);
+  double sum[4] = {};
+  uint32_t worst[4] = {};
+  for (unsigned b = 0; b < BOOTS; b++) {
+    Latency latency;
+    if (not simulate(rng, latency)) {
+      return EXIT_FAILURE;
+    }
+    const uint32_t values[4] = {latency.second, latency.time, latency.date, latency.frame};
+    for (int i = 0; i < 4; i++) {
+      sum[i] += values[i];
+      worst[i] = std::max(worst[i], values[i]);
+    }
+  }
+  const char* const names[4] = {"second of minute", "time (PARTIAL_TIME)",
+      "date (PARTIAL_DATE)", "first complete frame"};
+  printf("latency from power up to         %12s %12s\n", "mean", "worst");
+  for (int i = 0; i < 4; i++) {
+    printf("  %-30s %10.1f s %10.1f s\n", names[i], sum[i] / BOOTS / 1000, worst[i] / 1000.0);
+  }
+  if (sum[1] >= sum[3]) {
+    printf("error: partial time is not faster than the complete frame\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of format_tm() and print_tm(). The output
+ * must match asctime_r() and strftime() of the C library. The print
+ * throughput is compared with the former implementations: asctime_r()
+ * on 32 bit targets and a chain of single Print calls on AVR.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "bench.h"
+
+namespace {
+
+constexpr size_t TIMES = 4096;
+
+/** A Print that counts the calls and the characters. */
+class CountingPrint : public Print {
+public:
+  size_t mCalls = 0;
+  size_t mChars = 0;
+
+  size_t write(uint8_t) override {
+    mCalls++;
+    mChars++;
+    return 1;
+  }
+  size_t write(const uint8_t*, size_t size) override {
+    mCalls++;
+    mChars += size;
+    return size;
+  }
+  using Print::write;
+};
+
+namespace former {
+
+size_t printAsctime(Print& p, const DCF77::tm& time) {
+  char buffer[26];
+  asctime_r(&time, buffer);
+  buffer[24] = '\0';
+  return p.print(buffer);
+}
+
+const char* MO[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+const char* WD[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+size_t printFields(Print& p, const DCF77::tm& time) {
+  size_t n = 0;
+  n+= p.print(WD[time.tm_wday]);
+  n+= p.print(" ");
+  n+= p.print(MO[time.tm_mon]);
+  n+= p.print(" ");
+  n+= p.print(time.tm_mday);
+  n+= p.print(" ");
+  if(time.tm_hour < 10) {n+= p.print('0');}
+  n+= p.print(time.tm_hour);
+  n+= p.print(":");
+  if(time.tm_min < 10) {n+= p.print('0');}
+  n+= p.print(time.tm_min);
+  n+= p.print(":");
+  if(time.tm_sec < 10) {n+= p.print('0');}
+  n+= p.print(time.tm_sec);
+  n+= p.print(" ");
+  n+= p.print(time.tm_year + 1900);
+  return n;
+}
+
+} // namespace former
+
+} // anonymous namespace
+
+int main() {
+  srand(21);
+  std::vector<DCF77::tm> times(TIMES);
+  for (DCF77::tm& t : times) {
+    // 1900 to 2199, the range of the calendar conversions.
+    const int64_t ts = -2208988800LL + static_cast<int64_t>(
+        (static_cast<uint64_t>(rand()) << 20 ^ rand()) % 9467020800ULL);
+    const ::time_t stamp = static_cast< ::time_t>(ts);
+    gmtime_r(&stamp, &t);
+  }
+
+  for (const DCF77::tm& t : times) {
+    char expected[32];
+    char actual[DCF77::TM_FORMAT_SIZE];
+    asctime_r(&t, expected);
+    expected[24] = '\0';
+    size_t n = DCF77::format_tm(actual, t);
+    if (n != strlen(expected) || strcmp(actual, expected) != 0) {
+      printf("error: format_tm() gives \"%s\", asctime_r() \"%s\"\n", actual, expected);
+      return EXIT_FAILURE;
+    }
+    strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%S", &t);
+    n = DCF77::format_tm(actual, t, DCF77::ISO8601);
+    if (n != strlen(expected) || strcmp(actual, expected) != 0) {
+      printf("error: format_tm() gives \"%s\", strftime() \"%s\"\n", actual, expected);
+      return EXIT_FAILURE;
+    }
+  }
+
+  CountingPrint out;
+  PrintableDCF77tm printable;
+  static_cast<DCF77::tm&>(printable) = times[0];
+  out.print(printable);
+  if (out.mCalls != 1 || out.mChars != 24) {
+    printf("error: printTo() made %zu calls for %zu characters\n", out.mCalls, out.mChars);
+    return EXIT_FAILURE;
+  }
+
+  CountingPrint fieldsOut;
+  former::printFields(fieldsOut, times[0]);
+  printf("Print calls per time stamp: %zu (former AVR), 1 (print_tm)\n", fieldsOut.mCalls);
+
+  char buffer[DCF77::TM_FORMAT_SIZE];
+  const double nsAsctime = bench::nsPerOp(TIMES, [&]() {
+    for (const DCF77::tm& t : times) {
+      former::printAsctime(out, t);
+    }
+  });
+  const double nsFields = bench::nsPerOp(TIMES, [&]() {
+    for (const DCF77::tm& t : times) {
+      former::printFields(out, t);
+    }
+  });
+  const double nsPrint = bench::nsPerOp(TIMES, [&]() {
+    for (const DCF77::tm& t : times) {
+      DCF77::print_tm(out, t);
+    }
+  });
+  const double nsFormat = bench::nsPerOp(TIMES, [&]() {
+    for (const DCF77::tm& t : times) {
+      bench::doNotOptimize(DCF77::format_tm(buffer, t));
+    }
+  });
+  const double nsIso = bench::nsPerOp(TIMES, [&]() {
+    for (const DCF77::tm& t : times) {
+      bench::doNotOptimize(DCF77::format_tm(buffer, t, DCF77::ISO8601));
+    }
+  });
+  bench::report("asctime_r + print (former)", nsAsctime, "ns/time");
+  bench::report("field by field print (former AVR)", nsFields, "ns/time");
+  bench::report("print_tm", nsPrint, "ns/time");
+  bench::report("format_tm ASCTIME", nsFormat, "ns/time");
+  bench::report("format_tm ISO8601", nsIso, "ns/time");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host benchmark of dcf77frame2time() against the former implementation,
+ * which reinterpreted the frame as a bit field structure and fixed up
+ * every BCD field with a divide and multiply. Both are checked to produce
+ * identical results for arbitrary bit patterns before they are timed.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "bench.h"
+
+namespace {
+
+struct DCF77bits {
+  uint64_t prefix:15;
+  uint64_t R      :1;
+  uint64_t A1     :1;
+  uint64_t Z1     :1;
+  uint64_t Z2     :1;
+  uint64_t A2     :1;
+  uint64_t S      :1;
+  uint64_t Min    :7;
+  uint64_t P1     :1;
+  uint64_t Hour   :6;
+  uint64_t P2     :1;
+  uint64_t Day    :6;
+  uint64_t Weekday:3;
+  uint64_t Month  :5;
+  uint64_t Year   :8;
+  uint64_t P3     :1;
+};
+
+__attribute__((noinline))
+void legacyFrame2time(DCF77::tm &time, const uint64_t& dcf77frame) {
+  const DCF77bits& bits = reinterpret_cast<const DCF77bits&>(dcf77frame);
+  time.tm_sec = 0;
+  time.tm_min = bits.Min - ((bits.Min / 16) * 6);
+  time.tm_hour = bits.Hour - ((bits.Hour / 16) * 6);
+  time.tm_wday = (bits.Weekday - ((bits.Weekday / 16) * 6)) % 7;
+  time.tm_mday = bits.Day - ((bits.Day / 16) * 6);
+  time.tm_mon = bits.Month - ((bits.Month / 16) * 6) - 1;
+  time.tm_yday = -1;
+  time.tm_year = 100 + bits.Year - ((bits.Year / 16) * 6);
+  time.tm_isdst = bits.Z1;
+}
+
+bool operator!=(const DCF77::tm& a, const DCF77::tm& b) {
+  return a.tm_sec != b.tm_sec || a.tm_min != b.tm_min || a.tm_hour != b.tm_hour
+      || a.tm_wday != b.tm_wday || a.tm_mday != b.tm_mday || a.tm_mon != b.tm_mon
+      || a.tm_yday != b.tm_yday || a.tm_year != b.tm_year || a.tm_isdst != b.tm_isdst;
+}
+
+uint64_t randomBits() {
+  return static_cast<uint64_t>(rand()) << 40 ^ static_cast<uint64_t>(rand()) << 20 ^ rand();
+}
+
+} // anonymous namespace
+
+int main() {
+  srand(1);
+
+  // Every field is at most 8 bits wide. Sweeping each byte value through
+  // all field positions covers every field value, random patterns cover
+  // the combinations.
+  for (unsigned pos = 0; pos < 64; pos++) {
+    for (uint64_t v = 0; v < 256; v++) {
+      const uint64_t frame = v << pos;
+      DCF77::tm expected, actual;
+      legacyFrame2time(expected, frame);
+      DCF77rxbase::dcf77frame2time(actual, frame);
+      if (expected != actual) {
+        printf("error: dcf77frame2time(0x%016llx) differs\n", static_cast<unsigned long long>(frame));
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  std::vector<uint64_t> frames(4096);
+  for (uint64_t& f : frames) {
+    f = randomBits();
+    DCF77::tm expected, actual;
+    legacyFrame2time(expected, f);
+    DCF77rxbase::dcf77frame2time(actual, f);
+    if (expected != actual) {
+      printf("error: dcf77frame2time(0x%016llx) differs\n", static_cast<unsigned long long>(f));
+      return EXIT_FAILURE;
+    }
+  }
+
+  const size_t ops = frames.size() * 256;
+  const double legacyCycles = bench::cyclesPerOp(ops, [&]() {
+    DCF77::tm tm;
+    for (int r = 0; r < 256; r++) {
+      for (const uint64_t f : frames) {
+        legacyFrame2time(tm, f);
+        bench::doNotOptimize(tm);
+      }
+    }
+  });
+  const double tableCycles = bench::cyclesPerOp(ops, [&]() {
+    DCF77::tm tm;
+    for (int r = 0; r < 256; r++) {
+      for (const uint64_t f : frames) {
+        DCF77rxbase::dcf77frame2time(tm, f);
+        bench::doNotOptimize(tm);
+      }
+    }
+  });
+
+  bench::report("dcf77frame2time bit field (former)", legacyCycles, "cycles/frame");
+  bench::report("dcf77frame2time table driven", tableCycles, "cycles/frame");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of dcf77frame2utc() against the chain of
+ * dcf77frame2time(), tm_to_timestamp() and the CET / CEST offset, that
+ * consumers used so far. The check covers every valid frame: all
+ * minutes from 2000 to 2099 in CET and in CEST.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "internal/DCF77calendar.h"
+#include "internal/DCF77frame.h"
+#include "bench.h"
+
+namespace {
+
+constexpr uint32_t DAYS_1970_TO_2000 = 10957;
+constexpr uint32_t DAYS_2000_TO_2100 = 36525;
+constexpr size_t FRAMES = 4096;
+constexpr int REPEAT = 64;
+
+DCF77::time_t chain(const uint64_t frame) {
+  DCF77::tm tm;
+  DCF77rxbase::dcf77frame2time(tm, frame);
+  return DCF77::tm_to_timestamp(tm) - (tm.tm_isdst ? 7200 : 3600);
+}
+
+/* The date section of a frame with the bits of minute, hour and zone 0. */
+uint64_t dateBits(const uint32_t days) {
+  const DCF77calendar::civil_t civil = DCF77calendar::civil_from_days(days);
+  return bench::encodeFrame(civil.year - 2000, civil.month, civil.mday,
+      civil.wday == 0 ? 7 : civil.wday, 0, 0, false)
+      & ~(DCF77frame::Z2::insert(1) | DCF77frame::S::insert(1)
+      | DCF77frame::MinSection::insert(0xFF) | DCF77frame::HourSection::insert(0x7F));
+}
+
+/* Minute, hour and zone of a frame with the date section 0. */
+uint64_t timeBits(const unsigned minuteOfDay, const bool cest) {
+  return bench::encodeFrame(0, 0, 0, 0, minuteOfDay / 60, minuteOfDay % 60, cest)
+      & ~DCF77frame::DateSection::insert(0x7FFFFF);
+}
+
+} // anonymous namespace
+
+int main() {
+  std::vector<uint64_t> times(2 * 1440);
+  for (unsigned m = 0; m < 1440; m++) {
+    times[2 * m] = timeBits(m, false);
+    times[2 * m + 1] = timeBits(m, true);
+  }
+
+  size_t checked = 0;
+  for (uint32_t d = 0; d < DAYS_2000_TO_2100; d++) {
+    const uint32_t days = DAYS_1970_TO_2000 + d;
+    const uint64_t date = dateBits(days);
+    for (unsigned i = 0; i < times.size(); i++) {
+      const uint64_t frame = date | times[i];
+      const DCF77::time_t expected = days * 86400 + (i / 2) * 60 - (i & 1 ? 7200 : 3600);
+      const DCF77::time_t direct = DCF77rxbase::dcf77frame2utc(frame);
+      if (direct != expected || chain(frame) != expected) {
+        printf("error: frame 0x%016llx converts to %lu, expected %lu\n",
+            static_cast<unsigned long long>(frame), static_cast<unsigned long>(direct),
+            static_cast<unsigned long>(expected));
+        return EXIT_FAILURE;
+      }
+      checked++;
+    }
+  }
+  printf("%zu frames checked\n", checked);
+
+  srand(20);
+  std::vector<uint64_t> frames(FRAMES);
+  for (uint64_t& frame : frames) {
+    frame = dateBits(DAYS_1970_TO_2000 + rand() % DAYS_2000_TO_2100) | times[rand() % times.size()];
+  }
+  std::vector<DCF77::time_t> utc(FRAMES);
+  const size_t ops = FRAMES * REPEAT;
+  const double nsChain = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      for (size_t i = 0; i < FRAMES; i++) {
+        utc[i] = chain(frames[i]);
+      }
+      bench::doNotOptimize(utc[0]);
+    }
+  });
+  const double nsDirect = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      for (size_t i = 0; i < FRAMES; i++) {
+        utc[i] = DCF77rxbase::dcf77frame2utc(frames[i]);
+      }
+      bench::doNotOptimize(utc[0]);
+    }
+  });
+  const double nsBatch = bench::nsPerOp(ops, [&]() {
+    for (int r = 0; r < REPEAT; r++) {
+      DCF77rxbase::dcf77frames2utc(utc.data(), frames.data(), FRAMES);
+      bench::doNotOptimize(utc[0]);
+    }
+  });
+  bench::report("dcf77frame2time + tm_to_timestamp", nsChain, "ns/frame");
+  bench::report("dcf77frame2utc", nsDirect, "ns/frame");
+  bench::report("dcf77frames2utc (batch)", nsBatch, "ns/frame");
+  bench::report("dcf77frame2utc speedup", nsChain / nsDirect, "x");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of the glitch filter and the interrupt storm
+ * protection of DCF77rxStatic. The pulses are overlaid with short spikes
+ * in every second, and now and then with a burst of edges as from a
+ * switching supply. Three receivers decode the same input: without
+ * protection, with the glitch filter, and with glitch filter and storm
+ * protection. Reported are the received frames, the interrupt handler
+ * calls in total and in the busiest second, and the host CPU time per
+ * simulated second including the calls of poll().
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DCF77rxStatic.h"
+#include "bench.h"
+
+namespace {
+
+constexpr int PLAIN_PIN = 2;
+constexpr int FILTERED_PIN = 3;
+constexpr int PROTECTED_PIN = 4;
+constexpr unsigned MINUTES = 60;
+constexpr uint64_t MINUTE_US = 60000000ULL;
+/* Start one second in, the first minute mark needs a gap before. */
+constexpr uint64_t START_US = 1000000;
+/* poll() is called every 10ms. */
+constexpr uint64_t POLL_US = 10000;
+/* Spikes per second, 0.2ms to 3ms wide. */
+constexpr unsigned SPIKES_PER_SECOND = 4;
+/* A burst of an edge every 100us for 300ms, in every 5th minute. */
+constexpr unsigned BURST_EDGES = 3000;
+constexpr uint64_t BURST_PERIOD_US = 100;
+
+typedef DCF77rxPolicy<DCF77millis, 170, 1200, DCF77_PULSE_QUEUE_SIZE, 8> FilterPolicy;
+typedef DCF77rxPolicy<DCF77millis, 170, 1200, DCF77_PULSE_QUEUE_SIZE, 8, 20> ProtectPolicy;
+
+std::vector<uint64_t> gFrames;
+
+uint64_t frameOfMinute(unsigned m) {
+  return bench::encodeFrame(25, 11, 3, 1, 8 + m / 60, m % 60, false);
+}
+
+struct Tally {
+  unsigned good = 0;
+  unsigned wrong = 0;
+
+  void count(const uint64_t dcf77frame, const uint32_t systick) {
+    // The frame of minute m is concluded at the mark of minute m + 1.
+    const uint64_t us = static_cast<uint64_t>(systick) * 1000;
+    const unsigned m = static_cast<unsigned>((us + MINUTE_US / 2 - START_US) / MINUTE_US);
+    const uint64_t mark = START_US + m * MINUTE_US;
+    // A spike at the minute mark shifts it by a few milliseconds.
+    const bool onMark = us + 10000 > mark && us < mark + 10000;
+    if (m >= 1 && m <= MINUTES && onMark && dcf77frame == gFrames[m - 1]) {
+      good++;
+    } else {
+      wrong++;
+    }
+  }
+};
+
+template<int PIN, typename POLICY> class Rx
+    : public DCF77rxStatic<Rx<PIN, POLICY>, PIN, POLICY> {
+public:
+  Tally mTally;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    mTally.count(dcf77frame, systick);
+  }
+};
+
+typedef Rx<PLAIN_PIN, DCF77rxPolicy<>> PlainRx;
+typedef Rx<FILTERED_PIN, FilterPolicy> FilteredRx;
+typedef Rx<PROTECTED_PIN, ProtectPolicy> ProtectedRx;
+
+/**
+ * Every edge toggles the level, so the clean pulses, the spikes and the
+ * bursts can simply be merged by time.
+ */
+std::vector<bench::Edge> makeEdges() {
+  std::mt19937 rng(15);
+  std::uniform_int_distribution<uint64_t> inSecond(0, 999999);
+  std::uniform_int_distribution<uint64_t> spikeWidth(200, 3000);
+  std::vector<uint64_t> toggles;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    gFrames.push_back(frameOfMinute(m));
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, gFrames.back(), START_US + m * MINUTE_US);
+    for (const bench::Edge& e : minute) {
+      toggles.push_back(e.us);
+    }
+    for (unsigned s = 0; s < 60; s++) {
+      const uint64_t second = START_US + m * MINUTE_US + s * 1000000ULL;
+      for (unsigned i = 0; i < SPIKES_PER_SECOND; i++) {
+        const uint64_t at = second + inSecond(rng);
+        toggles.push_back(at);
+        toggles.push_back(at + spikeWidth(rng));
+      }
+    }
+    if (m % 5 == 2) {
+      const uint64_t at = START_US + m * MINUTE_US + (10 + m % 40) * 1000000ULL + 400000;
+      for (unsigned i = 0; i < BURST_EDGES; i++) {
+        toggles.push_back(at + i * BURST_PERIOD_US + 37);
+      }
+    }
+  }
+  toggles.push_back(START_US + MINUTES * MINUTE_US);
+  std::sort(toggles.begin(), toggles.end());
+  // Coinciding toggles cancel each other.
+  std::vector<bench::Edge> edges;
+  int level = HIGH;
+  for (size_t i = 0; i < toggles.size(); i++) {
+    if (i + 1 < toggles.size() && toggles[i] == toggles[i + 1]) {
+      i++;
+      continue;
+    }
+    level = level == HIGH ? LOW : HIGH;
+    edges.push_back(bench::Edge{toggles[i], level});
+  }
+  return edges;
+}
+
+struct Run {
+  unsigned calls = 0;
+  unsigned peakCalls = 0;
+  double nsPerSecond = 0;
+};
+
+/**
+ * Replay the edges on pin and poll the receiver every POLL_US. Counts
+ * the interrupt handler calls and measures the CPU time.
+ */
+template<typename RX> Run replay(RX& rx, const int pin, const std::vector<bench::Edge>& edges) {
+  Run run;
+  std::vector<unsigned> callsPerSecond(edges.back().us / 1000000 + 1);
+  uint64_t nextPoll = POLL_US;
+  const uint64_t start = bench::nowNs();
+  for (const bench::Edge& e : edges) {
+    while (nextPoll <= e.us) {
+      ArduinoHost::setMicros(nextPoll);
+      rx.poll();
+      nextPoll += POLL_US;
+    }
+    ArduinoHost::setMicros(e.us);
+    callsPerSecond[e.us / 1000000] += ArduinoHost::isAttached(pin);
+    ArduinoHost::setPinLevel(pin, e.level);
+  }
+  const double seconds = static_cast<double>(edges.back().us) / 1e6;
+  run.nsPerSecond = static_cast<double>(bench::nowNs() - start) / seconds;
+  for (const unsigned calls : callsPerSecond) {
+    run.calls += calls;
+    run.peakCalls = std::max(run.peakCalls, calls);
+  }
+  return run;
+}
+
+void report(const char* name, const Tally& tally, const Run& run,
+    uint32_t glitches, uint32_t storms) {
+  printf("%-22s %2u good %u wrong frames, %5u glitches %2u storms, "
+      "%5u isr calls, peak %4u/s, %4.0f ns cpu/s\n", name, tally.good, tally.wrong,
+      glitches, storms, run.calls, run.peakCalls, run.nsPerSecond);
+}
+
+} // anonymous namespace
+
+int main() {
+  const std::vector<bench::Edge> edges = makeEdges();
+  printf("%zu edges in %u minutes\n", edges.size(), MINUTES);
+
+  ArduinoHost::reset();
+  PlainRx plain;
+  plain.begin();
+  const Run plainRun = replay(plain, PLAIN_PIN, edges);
+
+  ArduinoHost::reset();
+  FilteredRx filtered;
+  filtered.begin();
+  const Run filteredRun = replay(filtered, FILTERED_PIN, edges);
+
+  ArduinoHost::reset();
+  ProtectedRx protectedRx;
+  protectedRx.begin();
+  const Run protectedRun = replay(protectedRx, PROTECTED_PIN, edges);
+
+  report("no filter", plain.mTally, plainRun, 0, 0);
+  report("glitch filter", filtered.mTally, filteredRun, filtered.glitchCount(), 0);
+  report("glitch filter + storm", protectedRx.mTally, protectedRun,
+      protectedRx.glitchCount(), protectedRx.stormCount());
+
+  // The burst minutes may be lost. All others must be received by the
+  // filtered receivers, without any wrong frame. The storm protection
+  // limits the calls per window of a second. A second of the clock
+  // overlaps two windows.
+  const unsigned bursts = MINUTES / 5;
+  const unsigned expected = MINUTES - 2 * bursts;
+  if (filtered.mTally.wrong || protectedRx.mTally.wrong
+      || filtered.mTally.good < expected || protectedRx.mTally.good < expected
+      || protectedRx.stormCount() < bursts
+      || protectedRun.peakCalls > 2 * (ProtectPolicy::STORM_EDGES + 1)) {
+    printf("error: glitches or storms not handled\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host validation of the drift estimation and holdover of
+ * DCF77wallclock. The system tick runs off by a fixed drift plus a slow
+ * wander, and its minute mark time stamps carry a jitter of +-1ms.
+ * The clock is trained with one frame per minute for an hour, across
+ * the change to CEST, then the signal is lost for 30 minutes. The time
+ * read during the outage is compared with the true time, once with a
+ * clock that got only the last frame before the outage, i.e. without
+ * drift estimate, and once with the trained clock.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <random>
+
+#include "DCF77rxtm.h"
+#include "DCF77wallclock.h"
+#include "bench.h"
+
+namespace {
+
+constexpr unsigned TRAINING_MINUTES = 60;
+constexpr unsigned OUTAGE_MINUTES = 30;
+constexpr uint64_t MINUTE_US = 60000000ULL;
+/* 2025-03-30 01:30 CET, the clocks go forward at 02:00 CET. */
+constexpr DCF77::time_t START_UTC = 1743294600;
+
+struct LocalClock {
+  double driftPpm;
+  double wanderPpm;
+
+  /* The local tick time in us at true time t in us. */
+  uint64_t at(const uint64_t t) const {
+    const double s = t / 1e6;
+    // The wander is a slow sine with a period of 2 hours.
+    const double phase = wanderPpm * 7200 / (2 * M_PI) * (1 - cos(2 * M_PI * s / 7200));
+    return static_cast<uint64_t>(t + driftPpm * s + phase) + 1000000000ULL;
+  }
+};
+
+uint64_t frameAt(const DCF77::time_t utc) {
+  // CEST from 01:00 UTC on.
+  const bool cest = utc >= 1743296400;
+  DCF77::tm tm;
+  DCF77::timestamp_to_tm(tm, utc + (cest ? 7200 : 3600), cest);
+  return DCF77rxbase::dcf77time2frame(tm);
+}
+
+/* The error of the clock at true time t in ms. */
+double clockError(DCF77wallclock& clock, const LocalClock& local, const uint64_t t) {
+  ArduinoHost::setMicros(local.at(t));
+  DCF77::time_t timestamp;
+  unsigned millisec;
+  if (not clock.getTimestamp(timestamp, &millisec)) {
+    return 1e9;
+  }
+  const double utc = static_cast<double>(timestamp - clock.utcOffset()) + millisec / 1e3;
+  return (utc - (START_UTC + t / 1e6)) * 1e3;
+}
+
+struct Result {
+  double rawError;
+  double disciplinedError;
+  uint32_t bound;
+  float estimatedPpm;
+  bool boundHeld;
+};
+
+Result simulate(const LocalClock& local, std::mt19937& rng) {
+  std::uniform_int_distribution<int> jitter(-1000, 1000);
+  ArduinoHost::reset();
+  DCF77wallclock trained;
+  DCF77wallclock raw;
+  Result result = Result();
+  result.boundHeld = true;
+
+  for (unsigned m = 0; m <= TRAINING_MINUTES; m++) {
+    const uint64_t t = m * MINUTE_US;
+    const uint64_t systickUs = local.at(t) + jitter(rng);
+    ArduinoHost::setMicros(systickUs + 1000);
+    trained.update(frameAt(START_UTC + m * 60), static_cast<uint32_t>(systickUs / 1000));
+    if (m == TRAINING_MINUTES) {
+      raw.update(frameAt(START_UTC + m * 60), static_cast<uint32_t>(systickUs / 1000));
+    }
+    // Read the time now and then, as an application would.
+    clockError(trained, local, t + 30 * 1000000ULL * (m < TRAINING_MINUTES));
+  }
+
+  // Read through the outage. The bound must hold all the time. The
+  // reading starts after the time stamp of the last minute mark.
+  const uint64_t outageStart = TRAINING_MINUTES * MINUTE_US + 2000;
+  for (uint64_t t = outageStart; t <= outageStart + OUTAGE_MINUTES * MINUTE_US;
+      t += 10 * 1000000ULL + 7777) {
+    const double error = clockError(trained, local, t);
+    if (fabs(error) > trained.holdoverErrorMillis()) {
+      result.boundHeld = false;
+    }
+    result.disciplinedError = error;
+    result.bound = trained.holdoverErrorMillis();
+    result.rawError = clockError(raw, local, t);
+    if (fabs(result.rawError) > raw.holdoverErrorMillis()) {
+      result.boundHeld = false;
+    }
+  }
+  result.estimatedPpm = trained.driftPpm();
+  return result;
+}
+
+} // anonymous namespace
+
+int main() {
+  static const LocalClock clocks[] = {
+    {0, 0}, {347, 0}, {-512, 0}, {1800, 0}, {-120, 2}, {650, 5}, {-3000, 1},
+  };
+  std::mt19937 rng(16);
+  bool failed = false;
+  printf("%9s %7s %10s | after %u min outage: %10s %12s %9s\n", "drift", "wander",
+      "estimated", OUTAGE_MINUTES, "raw error", "disciplined", "bound");
+  for (const LocalClock& local : clocks) {
+    const Result r = simulate(local, rng);
+    printf("%5.0f ppm %3.0f ppm %6.1f ppm | %24.1f ms %9.1f ms %6u ms%s\n",
+        local.driftPpm, local.wanderPpm, r.estimatedPpm, r.rawError,
+        r.disciplinedError, r.bound, r.boundHeld ? "" : "  bound violated");
+    failed |= not r.boundHeld || fabs(r.disciplinedError) > 25
+        || fabs(r.estimatedPpm - local.driftPpm) > 3 + local.wanderPpm;
+  }
+  if (failed) {
+    printf("error: drift not corrected\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
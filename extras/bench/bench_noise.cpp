@@ -0,0 +1,252 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Decode rate of the edge decoder under noise. The synthetic signal of
+ * signal.h is fed through the simulated pin for a sweep of the noise
+ * parameters. Reported are the frame yield, the rate of delivered
+ * frames that differ from the transmitted ones and the time to first
+ * fix from a random phase of the minute. The decoder is run with and
+ * without glitch filter.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "bench.h"
+#include "signal.h"
+
+namespace {
+
+constexpr int PLAIN_PIN = 2;
+constexpr int FILTERED_PIN = 3;
+constexpr unsigned RUNS = 16;
+constexpr unsigned MINUTES = 30;
+/* 2026-03-29 00:00:00 UTC, the timeline crosses the change to CEST. */
+constexpr DCF77::time_t TIMELINE_START = 1774742400;
+
+struct Received {
+  uint64_t frame;
+  uint32_t systick;
+};
+
+template<int PIN, typename POLICY> class Rx : public DCF77rxStatic<Rx<PIN, POLICY>, PIN, POLICY> {
+public:
+  std::vector<Received> mFrames;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    mFrames.push_back(Received{dcf77frame, systick});
+  }
+};
+
+typedef Rx<PLAIN_PIN, DCF77rxPolicy<>> PlainRx;
+typedef Rx<FILTERED_PIN, DCF77rxPolicy<DCF77millis, 170, 1200,
+    DCF77_PULSE_QUEUE_SIZE, 10>> FilteredRx;
+
+struct Score {
+  unsigned possible = 0;
+  unsigned correct = 0;
+  unsigned wrong = 0;
+  unsigned fixes = 0;
+  double ttffSeconds = 0;
+
+  double yield() const {
+    return possible ? 100.0 * correct / possible : 0;
+  }
+  double falseAccepts() const {
+    return correct + wrong ? 100.0 * wrong / (correct + wrong) : 0;
+  }
+  double ttff() const {
+    return fixes ? ttffSeconds / fixes : 0;
+  }
+};
+
+/**
+ * Compare the delivered frames with the transmitted ones. The frame of
+ * minute i is delivered at the mark of minute i + 1.
+ */
+void score(Score& s, const std::vector<Received>& received,
+    const std::vector<uint64_t>& frames, const uint64_t phaseUs) {
+  bool fixed = false;
+  for (const Received& r : received) {
+    const int64_t minute = (static_cast<int64_t>(r.systick) * 1000 - 1000000 + 30000000)
+        / 60000000 - 1;
+    if (minute >= 0 && minute < static_cast<int64_t>(frames.size())
+        && r.frame == frames[minute]) {
+      s.correct++;
+      if (not fixed) {
+        fixed = true;
+        s.fixes++;
+        s.ttffSeconds += (r.systick * 1000.0 - phaseUs) / 1e6;
+      }
+    } else {
+      s.wrong++;
+    }
+  }
+}
+
+bool run(const char* name, const bench::NoiseModel& noise, Score& plain, Score& filtered) {
+  for (unsigned r = 0; r < RUNS; r++) {
+    bench::SignalGenerator generator(noise, 1000 + r);
+    const DCF77::time_t start = TIMELINE_START + r * MINUTES * 60;
+    std::vector<bench::Edge> edges;
+    std::vector<uint64_t> frames;
+    for (unsigned m = 0; m < MINUTES; m++) {
+      const DCF77::time_t utc = start + m * 60;
+      frames.push_back(generator.appendMinute(edges, utc, m * 60000000ULL + 1000000));
+
+      // The generator is the inverse of the decoder's conversion.
+      DCF77::time_t decoded;
+      DCF77rxbase::dcf77frames2utc(&decoded, &frames.back(), 1);
+      if (decoded != utc + 60) {
+        printf("error: the frame of %lu decodes to %lu\n", static_cast<unsigned long>(utc),
+            static_cast<unsigned long>(decoded));
+        return false;
+      }
+    }
+    // The glitch filter delivers a frame with the end of the next pulse.
+    edges.push_back(bench::Edge{MINUTES * 60000000ULL + 1000000, LOW});
+    edges.push_back(bench::Edge{MINUTES * 60000000ULL + 1100000, HIGH});
+
+    // Switch on at a random phase of the first minute.
+    const uint64_t phaseUs = (r * 3733 % 60) * 1000000ULL + 500000;
+    ArduinoHost::reset();
+    ArduinoHost::setMicros(phaseUs);
+    PlainRx plainRx;
+    FilteredRx filteredRx;
+    plainRx.begin();
+    filteredRx.begin();
+    for (const bench::Edge& e : edges) {
+      if (e.us < phaseUs) {
+        continue;
+      }
+      ArduinoHost::setMicros(e.us);
+      ArduinoHost::setPinLevel(PLAIN_PIN, e.level);
+      ArduinoHost::setPinLevel(FILTERED_PIN, e.level);
+    }
+    // Complete minutes after switching on.
+    const unsigned possible = MINUTES - (phaseUs + 59000000) / 60000000;
+    plain.possible += possible;
+    filtered.possible += possible;
+    score(plain, plainRx.mFrames, frames, phaseUs);
+    score(filtered, filteredRx.mFrames, frames, phaseUs);
+  }
+  printf("%-26s %6.1f%% %6.2f%% %6.0fs %3u | %6.1f%% %6.2f%% %6.0fs %3u\n", name,
+      plain.yield(), plain.falseAccepts(), plain.ttff(), RUNS - plain.fixes,
+      filtered.yield(), filtered.falseAccepts(), filtered.ttff(), RUNS - filtered.fixes);
+  return true;
+}
+
+bench::NoiseModel jitter(uint32_t us) {
+  bench::NoiseModel noise;
+  noise.jitterUs = us;
+  return noise;
+}
+
+bench::NoiseModel spikes(double perSecond) {
+  bench::NoiseModel noise;
+  noise.spikesPerSecond = perSecond;
+  return noise;
+}
+
+bench::NoiseModel dropouts(double rate) {
+  bench::NoiseModel noise;
+  noise.dropoutRate = rate;
+  return noise;
+}
+
+bench::NoiseModel fades(double rate) {
+  bench::NoiseModel noise;
+  noise.fadeRate = rate;
+  return noise;
+}
+
+} // anonymous namespace
+
+int main() {
+  printf("%-26s %7s %7s %7s %3s | %7s %7s %7s %3s\n", "", "yield", "false", "ttff",
+      "nf", "yield", "false", "ttff", "nf");
+  printf("%-26s %-29s | %s\n", "noise", "edge decoder", "with 10ms glitch filter");
+
+  Score plain, filtered;
+  if (not run("none", bench::NoiseModel(), plain, filtered)) {
+    return EXIT_FAILURE;
+  }
+  if (plain.yield() < 100 || plain.wrong || filtered.yield() < 100 || filtered.wrong) {
+    printf("error: the ideal signal isn't decoded completely\n");
+    return EXIT_FAILURE;
+  }
+
+  const uint32_t jitters[] = {20000, 40000};
+  for (const uint32_t us : jitters) {
+    char name[32];
+    snprintf(name, sizeof(name), "jitter %ums", static_cast<unsigned>(us / 1000));
+    Score p, f;
+    if (not run(name, jitter(us), p, f)) {
+      return EXIT_FAILURE;
+    }
+    // Below 30ms jitter the pulse widths stay clear of the 170ms split.
+    if (us < 30000 && (p.yield() < 100 || p.wrong || f.wrong)) {
+      printf("error: jitter leads to wrong frames\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  const double spikeRates[] = {0.1, 0.5, 2};
+  for (const double rate : spikeRates) {
+    char name[32];
+    snprintf(name, sizeof(name), "spikes %.1f/s", rate);
+    Score p, f;
+    run(name, spikes(rate), p, f);
+  }
+
+  const double dropoutRates[] = {0.01, 0.05};
+  for (const double rate : dropoutRates) {
+    char name[32];
+    snprintf(name, sizeof(name), "dropouts %.0f%%", rate * 100);
+    Score p, f;
+    run(name, dropouts(rate), p, f);
+  }
+
+  const double fadeRates[] = {0.005, 0.02};
+  for (const double rate : fadeRates) {
+    char name[32];
+    snprintf(name, sizeof(name), "fades %.1f%%/s", rate * 100);
+    Score p, f;
+    run(name, fades(rate), p, f);
+  }
+
+  bench::NoiseModel combined;
+  combined.jitterUs = 20000;
+  combined.spikesPerSecond = 0.5;
+  combined.dropoutRate = 0.01;
+  combined.fadeRate = 0.005;
+  Score p, f;
+  run("combined", combined, p, f);
+
+  printf("yield: correct frames per complete minute, false: wrong frames per\n"
+      "delivered frame, ttff: mean time to first fix, nf: runs without fix\n");
+  return EXIT_SUCCESS;
+}
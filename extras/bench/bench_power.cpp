@@ -0,0 +1,215 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+/**
+ * Host simulation of the duty-cycled receiver operation. Three days of
+ * a synthetic signal, with an outage of six hours, are received through
+ * DCF77powerScheduler on a board whose system tick runs fast by 80 ppm.
+ * Checked are the error of the wall clock against the true time, that
+ * the pin interrupt is detached and the receiver is unpowered between
+ * the windows, and that the windows resume after the outage. Reported
+ * are the receiver on-time per day, the windows and the intervals.
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "DCF77rxStatic.h"
+#include "DCF77powerScheduler.h"
+#include "bench.h"
+#include "signal.h"
+
+namespace {
+
+constexpr int RX_PIN = 2;
+constexpr int ENABLE_PIN = 7;
+constexpr unsigned DAYS = 3;
+constexpr unsigned MINUTES = DAYS * 1440;
+/* No signal from hour 30 to hour 36. */
+constexpr unsigned OUTAGE_BEGIN_MINUTE = 30 * 60;
+constexpr unsigned OUTAGE_END_MINUTE = 36 * 60;
+/* 2026-03-28 00:00:00 UTC, the timeline crosses the change to CEST. */
+constexpr DCF77::time_t TIMELINE_START = 1774656000;
+constexpr uint64_t START_US = 1000000;
+/* The system tick runs fast. */
+constexpr int64_t DRIFT_PPM = 80;
+constexpr uint64_t POLL_US = 10000;
+constexpr uint64_t CHECK_US = 1000000;
+
+typedef DCF77powerPolicy<> PowerPolicy;
+
+class Receiver : public DCF77rxStatic<Receiver, RX_PIN> {
+public:
+  DCF77wallclock wallclock;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    wallclock.update(dcf77frame, systick);
+  }
+};
+
+typedef DCF77powerScheduler<Receiver, ENABLE_PIN, PowerPolicy> PowerScheduler;
+
+/** The system tick time of a true time since START_US. */
+uint64_t toHostUs(const uint64_t trueUs) {
+  return trueUs + (trueUs - START_US) * DRIFT_PPM / 1000000;
+}
+
+/** The true time of a system tick time. */
+uint64_t toTrueUs(const uint64_t hostUs) {
+  return START_US + (hostUs - START_US) * 1000000 / (1000000 + DRIFT_PPM);
+}
+
+std::vector<bench::Edge> makeEdges() {
+  bench::NoiseModel noise;
+  noise.jitterUs = 2000;
+  bench::SignalGenerator generator(noise, 31);
+  std::vector<bench::Edge> edges;
+  std::vector<bench::Edge> minute;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    minute.clear();
+    generator.appendMinute(minute, TIMELINE_START + 60 * m, START_US + m * 60000000ULL);
+    if (m >= OUTAGE_BEGIN_MINUTE && m < OUTAGE_END_MINUTE) {
+      continue;
+    }
+    for (const bench::Edge& e : minute) {
+      edges.push_back(bench::Edge{toHostUs(e.us), e.level});
+    }
+  }
+  return edges;
+}
+
+struct Window {
+  uint64_t openUs;
+  uint64_t closeUs;
+  bool synced;
+};
+
+} // anonymous namespace
+
+int main() {
+  const std::vector<bench::Edge> edges = makeEdges();
+
+  ArduinoHost::reset();
+  ArduinoHost::setMicros(0);
+  Receiver rx;
+  PowerScheduler power(rx, rx.wallclock);
+  power.begin();
+
+  unsigned errors = 0;
+  const auto fail = [&](const char* what, const uint64_t us) {
+    if (errors++ < 10) {
+      printf("error: %s at %.0f s\n", what, us / 1e6);
+    }
+  };
+
+  std::vector<Window> windows;
+  std::vector<uint32_t> intervals;
+  DCF77powerSchedulerbase::POWER_STATE state = power.state();
+  uint64_t windowOpen = 0;
+  uint32_t syncs = 0;
+  int64_t worstErrorMs = 0;
+  const uint64_t endUs = toHostUs(START_US + MINUTES * 60000000ULL);
+  size_t next = 0;
+  const uint64_t start = bench::nowNs();
+  for (uint64_t t = POLL_US; t <= endUs; t += POLL_US) {
+    while (next < edges.size() && edges[next].us <= t) {
+      ArduinoHost::setMicros(edges[next].us);
+      ArduinoHost::setPinLevel(RX_PIN, edges[next].level);
+      next++;
+    }
+    ArduinoHost::setMicros(t);
+    rx.poll();
+    const DCF77powerSchedulerbase::POWER_STATE now = power.poll();
+    if (now != state) {
+      if (state == DCF77powerSchedulerbase::POWER_OFF) {
+        windowOpen = t;
+      } else if (now == DCF77powerSchedulerbase::POWER_OFF) {
+        const bool synced = power.syncCount() != syncs;
+        syncs = power.syncCount();
+        windows.push_back(Window{windowOpen, t, synced});
+        intervals.push_back(power.intervalMillis());
+      }
+      state = now;
+    }
+
+    const bool listening = state == DCF77powerSchedulerbase::POWER_LISTEN;
+    if (ArduinoHost::isAttached(RX_PIN) != listening) {
+      fail("pin interrupt attached outside of the window", t);
+    }
+    const bool powered = state != DCF77powerSchedulerbase::POWER_OFF;
+    if ((ArduinoHost::pinLevel(ENABLE_PIN) == PowerPolicy::ENABLE_LEVEL) != powered) {
+      fail("receiver powered outside of the window", t);
+    }
+
+    DCF77::time_t local;
+    unsigned millisec;
+    if (t % CHECK_US == 0 && rx.wallclock.getTimestamp(local, &millisec)) {
+      const int64_t clockMs = (static_cast<int64_t>(local) - rx.wallclock.utcOffset()) * 1000
+          + millisec;
+      const int64_t trueMs = static_cast<int64_t>(TIMELINE_START) * 1000
+          + static_cast<int64_t>((toTrueUs(t) - START_US) / 1000);
+      const int64_t errorMs = clockMs > trueMs ? clockMs - trueMs : trueMs - clockMs;
+      worstErrorMs = std::max(worstErrorMs, errorMs);
+      if (errorMs > PowerPolicy::MAX_ERROR_MILLIS) {
+        fail("clock error beyond the bound", t);
+      }
+    }
+  }
+  const double cpuNsPerSecond = static_cast<double>(bench::nowNs() - start) / (endUs / 1e6);
+
+  unsigned afterOutage = 0;
+  for (size_t i = 0; i < windows.size(); i++) {
+    const Window& w = windows[i];
+    const uint64_t outageEnd = toHostUs(START_US + OUTAGE_END_MINUTE * 60000000ULL);
+    afterOutage += w.synced && w.openUs > outageEnd;
+    // The windows after the first are aligned to the minute marks and
+    // take the warm-up and a minute.
+    if (i != 0 && w.synced && w.closeUs - w.openUs > 90000000) {
+      fail("window not aligned to the minute", w.openUs);
+    }
+    printf("window %8.0f s to %8.0f s, %4.0f s on, %s\n", w.openUs / 1e6, w.closeUs / 1e6,
+        (w.closeUs - w.openUs) / 1e6, w.synced ? "synced" : "failed");
+  }
+  printf("intervals [min]:");
+  for (const uint32_t interval : intervals) {
+    printf(" %u", interval / 60000);
+  }
+  printf("\n");
+  const double onPerDay = static_cast<double>(power.onTimeSeconds()) / DAYS;
+  printf("%u windows synced, %u failed, worst clock error %lld ms\n",
+      static_cast<unsigned>(power.syncCount()), static_cast<unsigned>(power.failedCount()),
+      static_cast<long long>(worstErrorMs));
+  bench::report("receiver on-time per day", onPerDay, "s");
+  bench::report("receiver duty cycle", 100.0 * onPerDay / 86400, "%");
+  bench::report("host cpu per simulated second", cpuNsPerSecond, "ns");
+
+  // The outage makes windows fail, but the receiver is back in sync
+  // afterwards. On average, the receiver is on less than 2% of the
+  // day, the outage included.
+  if (power.failedCount() == 0 || afterOutage == 0 || onPerDay > 1728) {
+    printf("error: duty cycle not as expected\n");
+    errors++;
+  }
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
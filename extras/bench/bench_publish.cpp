@@ -0,0 +1,189 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+/**
+ * Stress test of DCF77frameSlot on the host. A writer thread plays the
+ * part of the receiver interrupt, here on another core, and publishes
+ * frames back to back. Reader threads copy snapshots concurrently and
+ * check them: frame and systick are derived from the sequence number,
+ * so a torn copy is detected, and the sequence must never go back.
+ * For comparison, the same is done with a plain struct, which is what
+ * the copy within noInterrupts() amounts to on a second core. Reported
+ * are the reads, the torn copies and the cost of publish() and read().
+ */
+
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "DCF77frameSlot.h"
+#include "bench.h"
+
+namespace {
+
+constexpr unsigned READERS = 3;
+constexpr uint32_t PUBLISHES = 4000000;
+
+/* The frame and the systick of a sequence number. */
+uint64_t frameOf(const uint32_t sequence) {
+  return 0x9E3779B97F4A7C15ULL * sequence;
+}
+
+uint32_t systickOf(const uint32_t sequence) {
+  return sequence * 1000u + 7u;
+}
+
+bool consistent(const DCF77frameSnapshot& snapshot) {
+  return snapshot.sequence == 0 ? snapshot.frame == 0 && snapshot.systick == 0
+      : snapshot.frame == frameOf(snapshot.sequence)
+          && snapshot.systick == systickOf(snapshot.sequence);
+}
+
+struct ReaderResult {
+  uint64_t reads = 0;
+  uint64_t torn = 0;
+  uint64_t backwards = 0;
+};
+
+/* The unprotected publication: a struct that is copied as it is. */
+struct PlainSlot {
+  volatile uint64_t frame = 0;
+  volatile uint32_t systick = 0;
+  volatile uint32_t sequence = 0;
+
+  void publish(const uint64_t dcf77frame, const uint32_t tick) {
+    frame = dcf77frame;
+    systick = tick;
+    sequence = sequence + 1;
+  }
+
+  bool read(DCF77frameSnapshot& snapshot) const {
+    snapshot.frame = frame;
+    snapshot.systick = systick;
+    snapshot.sequence = sequence;
+    return snapshot.sequence != 0;
+  }
+};
+
+template<typename SLOT> void stress(SLOT& slot, ReaderResult (&results)[READERS]) {
+  std::atomic<bool> done(false);
+  std::atomic<unsigned> ready(0);
+  std::vector<std::thread> readers;
+  for (unsigned r = 0; r < READERS; r++) {
+    readers.emplace_back([&slot, &done, &ready, &results, r]() {
+      ReaderResult& result = results[r];
+      uint32_t latest = 0;
+      ready++;
+      while (not done.load(std::memory_order_relaxed)) {
+        DCF77frameSnapshot snapshot;
+        slot.read(snapshot);
+        result.reads++;
+        if (not consistent(snapshot)) {
+          result.torn++;
+        } else if (snapshot.sequence < latest) {
+          result.backwards++;
+        } else {
+          latest = snapshot.sequence;
+        }
+      }
+    });
+  }
+  while (ready.load() != READERS) {
+    std::this_thread::yield();
+  }
+  std::thread writer([&slot]() {
+    for (uint32_t sequence = 1; sequence <= PUBLISHES; sequence++) {
+      slot.publish(frameOf(sequence), systickOf(sequence));
+    }
+  });
+  writer.join();
+  done = true;
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+}
+
+ReaderResult total(const ReaderResult (&results)[READERS]) {
+  ReaderResult sum;
+  for (const ReaderResult& result : results) {
+    sum.reads += result.reads;
+    sum.torn += result.torn;
+    sum.backwards += result.backwards;
+  }
+  return sum;
+}
+
+} // anonymous namespace
+
+int main() {
+  printf("%u readers, %u publishes, %u hardware threads\n", READERS,
+      static_cast<unsigned>(PUBLISHES), std::thread::hardware_concurrency());
+
+  DCF77frameSlot slot;
+  ReaderResult slotResults[READERS];
+  stress(slot, slotResults);
+  const ReaderResult slotTotal = total(slotResults);
+
+  PlainSlot plain;
+  ReaderResult plainResults[READERS];
+  stress(plain, plainResults);
+  const ReaderResult plainTotal = total(plainResults);
+
+  printf("%-16s %10llu reads %8llu torn %4llu backwards\n", "DCF77frameSlot",
+      static_cast<unsigned long long>(slotTotal.reads),
+      static_cast<unsigned long long>(slotTotal.torn),
+      static_cast<unsigned long long>(slotTotal.backwards));
+  printf("%-16s %10llu reads %8llu torn %4llu backwards\n", "plain struct",
+      static_cast<unsigned long long>(plainTotal.reads),
+      static_cast<unsigned long long>(plainTotal.torn),
+      static_cast<unsigned long long>(plainTotal.backwards));
+
+  // The uncontended costs.
+  DCF77frameSlot quiet;
+  constexpr size_t OPS = 1000000;
+  uint32_t sequence = 0;
+  bench::report("publish()", bench::nsPerOp(OPS, [&]() {
+    for (size_t i = 0; i < OPS; i++) {
+      sequence++;
+      quiet.publish(frameOf(sequence), systickOf(sequence));
+    }
+  }), "ns");
+  DCF77frameSnapshot snapshot;
+  bench::report("read()", bench::nsPerOp(OPS, [&]() {
+    for (size_t i = 0; i < OPS; i++) {
+      quiet.read(snapshot);
+      bench::doNotOptimize(snapshot);
+    }
+  }), "ns");
+
+  const DCF77frameSnapshot expected = {frameOf(PUBLISHES), systickOf(PUBLISHES), PUBLISHES};
+  DCF77frameSnapshot last;
+  if (slotTotal.torn != 0 || slotTotal.backwards != 0 || not slot.read(last)
+      || last.frame != expected.frame || last.systick != expected.systick
+      || last.sequence != expected.sequence) {
+    printf("error: inconsistent snapshot\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
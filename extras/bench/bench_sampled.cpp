@@ -0,0 +1,189 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host simulation of the frame yield of the edge decoder DCF77rx
+ * against the matched filter decoder DCF77sampledRx. Both receive the
+ * same noisy signal, the latter by sampling the pin every
+ * DCF77_SAMPLE_MILLIS. The signal is simulated with a resolution of
+ * 1ms. Noise is Gaussian jitter on the pulse edges and glitches of
+ * inverted level at random times.
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "DCF77sampledRx.h"
+#include "bench.h"
+
+namespace {
+
+constexpr uint8_t PIN = 3;
+constexpr unsigned MINUTES = 300;
+constexpr uint32_t MINUTE_MS = 60000;
+/* Sample ticks are not aligned to the second marks. */
+constexpr uint32_t TICK_OFFSET_MS = 3;
+
+/** The frame of minute m. Day 2025-03-01 is a Saturday. */
+uint64_t frameOfMinute(unsigned m) {
+  return bench::encodeFrame(25, 3, 1, 6, m / 60, m % 60, false);
+}
+
+struct Yield {
+  uint32_t frames = 0;
+  uint32_t wrongFrames = 0;
+
+  void count(uint64_t dcf77frame, uint32_t systick) {
+    const unsigned minute = (systick + MINUTE_MS / 2) / MINUTE_MS - 1;
+    frames++;
+    wrongFrames += dcf77frame != frameOfMinute(minute);
+  }
+};
+
+class EdgeRx : public DCF77rx<PIN> {
+public:
+  Yield mYield;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mYield.count(dcf77frame, systick);
+  }
+};
+
+class SampledRx : public DCF77sampledRx<PIN> {
+public:
+  Yield mYield;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mYield.count(dcf77frame, systick);
+  }
+};
+
+/**
+ * Receive MINUTES minutes with both decoders.
+ *
+ * @param sigmaMs Standard deviation of the edge jitter.
+ * @param glitchesPerSecond Mean number of glitches per second.
+ * @param maxGlitchMs Glitches last 1 to maxGlitchMs milliseconds.
+ */
+void simulate(double sigmaMs, double glitchesPerSecond, unsigned maxGlitchMs,
+    Yield& edge, Yield& sampled) {
+  std::mt19937 rng(9);
+  std::normal_distribution<double> jitter(0, sigmaMs);
+  std::poisson_distribution<int> glitches(glitchesPerSecond);
+  std::uniform_int_distribution<uint32_t> glitchStart(0, 999);
+  std::uniform_int_distribution<uint32_t> glitchLength(1, maxGlitchMs);
+
+  ArduinoHost::reset();
+  ArduinoHost::setPinLevel(PIN, HIGH);
+  EdgeRx edgeRx;
+  SampledRx sampledRx;
+  edgeRx.begin();
+  sampledRx.begin();
+
+  std::vector<uint8_t> level(MINUTE_MS);
+  int pinLevel = HIGH;
+  for (unsigned m = 1; m <= MINUTES; m++) {
+    const uint64_t frame = frameOfMinute(m);
+    std::fill(level.begin(), level.end(), HIGH);
+    for (unsigned sec = 0; sec < 59; sec++) {
+      const int32_t width = (frame >> sec) & 1 ? 200 : 100;
+      const int32_t mark = sec * 1000;
+      const int32_t fall = std::max<int32_t>(0, mark + static_cast<int32_t>(jitter(rng)));
+      const int32_t rise = std::max(fall + 1, mark + width + static_cast<int32_t>(jitter(rng)));
+      std::fill(level.begin() + fall, level.begin() + rise, LOW);
+    }
+    for (unsigned sec = 0; sec < 60; sec++) {
+      for (int g = glitches(rng); g > 0; g--) {
+        const uint32_t start = sec * 1000 + glitchStart(rng);
+        const uint32_t end = std::min(MINUTE_MS, start + glitchLength(rng));
+        for (uint32_t t = start; t < end; t++) {
+          level[t] = level[t] == LOW ? HIGH : LOW;
+        }
+      }
+    }
+
+    const uint64_t minuteStart = static_cast<uint64_t>(m) * MINUTE_MS;
+    for (uint32_t t = 0; t < MINUTE_MS; t++) {
+      ArduinoHost::setMicros((minuteStart + t) * 1000);
+      if (level[t] != pinLevel) {
+        pinLevel = level[t];
+        ArduinoHost::setPinLevel(PIN, pinLevel);
+      }
+      if (t % DCF77_SAMPLE_MILLIS == TICK_OFFSET_MS) {
+        SampledRx::sample();
+      }
+    }
+  }
+
+  edge = edgeRx.mYield;
+  sampled = sampledRx.mYield;
+}
+
+class NullRx : public DCF77sampledRx<PIN + 1> {
+  void onDCF77FrameReceived(const uint64_t, const uint32_t) override {
+  }
+};
+
+} // anonymous namespace
+
+int main() {
+  // Frames per hour, in brackets the frames with undetected bit errors,
+  // which passed the parity check.
+  printf("%-7s %-10s %-8s %18s %18s\n", "sigma", "glitches", "length",
+      "edge decoder", "matched filter");
+  struct {double sigmaMs; double glitchesPerSecond; unsigned maxGlitchMs;} const cases[] = {
+      {0, 0, 1}, {10, 0, 1}, {20, 0, 1}, {0, 0.02, 20}, {0, 0.1, 20},
+      {0, 0.5, 20}, {0, 2, 10}, {10, 0.1, 40}, {20, 0.5, 20}};
+  for (const auto& c : cases) {
+    Yield edge, sampled;
+    simulate(c.sigmaMs, c.glitchesPerSecond, c.maxGlitchMs, edge, sampled);
+    printf("%4.0fms %6.2f/s %5ums %9.1f fr/h (%2u) %9.1f fr/h (%2u)\n",
+        c.sigmaMs, c.glitchesPerSecond, c.maxGlitchMs,
+        edge.frames * 60.0 / MINUTES, static_cast<unsigned>(edge.wrongFrames),
+        sampled.frames * 60.0 / MINUTES, static_cast<unsigned>(sampled.wrongFrames));
+    // Without noise the matched filter must lock within 2 minutes and
+    // get every following frame.
+    if (c.sigmaMs == 0 && c.glitchesPerSecond == 0 && sampled.frames < MINUTES - 3) {
+      printf("error: matched filter lost frames without noise\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Cost of a sample tick, including the evaluation once per second.
+  ArduinoHost::reset();
+  NullRx rx;
+  rx.begin();
+  static constexpr size_t TICKS = 100000;
+  const double ns = bench::nsPerOp(TICKS, [&]() {
+    for (size_t i = 0; i < TICKS; i++) {
+      ArduinoHost::setPinLevel(PIN + 1, (i % 100) < 15 ? LOW : HIGH);
+      NullRx::sample();
+    }
+  });
+  bench::report("sample tick (DCF77sampledRx)", ns, "ns/tick");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,247 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of DCF77scheduler. Thousands of daily, one
+ * time and periodic events run through three days around each change
+ * between CET and CEST, while the clock is corrected by small and large
+ * jumps. Every tick must fire the same events as a linear scan over all
+ * events, and every daily event must fire exactly once per day.
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "DCF77scheduler.h"
+#include "bench.h"
+#include "signal.h"
+
+namespace {
+
+constexpr uint16_t CHECK_EVENTS = 1000;
+constexpr uint16_t BENCH_EVENTS = 10000;
+constexpr unsigned DAYS = 3;
+/* 2026-03-28 and 2026-10-24, 00:00:00 UTC. */
+constexpr DCF77::time_t SPRING = 1774656000;
+constexpr DCF77::time_t AUTUMN = 1792800000;
+
+typedef std::pair<DCF77schedulerbase::EVENT_ID, DCF77::time_t> Fired;
+
+template<uint16_t CAPACITY> class Scheduler : public DCF77scheduler<CAPACITY> {
+public:
+  std::vector<Fired> mFired;
+private:
+  void onScheduledEvent(const DCF77schedulerbase::EVENT_ID id, const DCF77::time_t due) override {
+    mFired.push_back(Fired(id, due));
+  }
+};
+
+/** The linear scan, that the scheduler must agree with. */
+class Reference {
+public:
+  struct Event {
+    DCF77::time_t due;
+    uint32_t period;
+    bool pending;
+    bool active;
+  };
+  std::vector<Event> mEvents;
+  std::vector<Fired> mFired;
+  bool mHasTime = false;
+
+  void add(DCF77::time_t due, uint32_t period, bool pending) {
+    mEvents.push_back(Event{due, period, pending, true});
+  }
+
+  void run(const DCF77::time_t now) {
+    if (not mHasTime) {
+      mHasTime = true;
+      for (Event& e : mEvents) {
+        if (e.pending) {
+          e.due += now - now % 86400;
+          if (e.due < now) {
+            e.due += 86400;
+          }
+        }
+      }
+    }
+    for (size_t id = 0; id < mEvents.size(); id++) {
+      Event& e = mEvents[id];
+      if (not e.active || e.due > now) {
+        continue;
+      }
+      mFired.push_back(Fired(static_cast<DCF77schedulerbase::EVENT_ID>(id), e.due));
+      if (e.period == 0) {
+        e.active = false;
+      } else {
+        e.due += e.period;
+        if (e.due <= now) {
+          e.due += ((now - e.due) / e.period + 1) * e.period;
+        }
+      }
+    }
+  }
+};
+
+/** The local time, corrected now and then by a jump. */
+class Clock {
+public:
+  explicit Clock(DCF77::time_t utc) : mUtc(utc) {
+  }
+
+  DCF77::time_t tick() {
+    mUtc++;
+    const unsigned second = static_cast<unsigned>(mUtc % 86400);
+    if (second % 3600 == 1800) {
+      mCorrection += rand() % 7 - 3;
+    }
+    if (second == 10 * 3600) {
+      mCorrection += 600;
+    } else if (second == 14 * 3600) {
+      mCorrection -= 300;
+    }
+    return mUtc + (bench::isCest(mUtc) ? 7200 : 3600) + mCorrection;
+  }
+
+private:
+  DCF77::time_t mUtc;
+  int32_t mCorrection = 0;
+};
+
+template<uint16_t CAPACITY> void schedule(Scheduler<CAPACITY>& scheduler, Reference& reference,
+    const DCF77::time_t start, std::vector<bool>& isDaily) {
+  // Random times of day, with extra weight on the hours around 02:00.
+  for (uint16_t i = 0; i < CAPACITY; i++) {
+    const unsigned kind = i % 5;
+    if (kind < 3) {
+      const uint32_t secondOfDay = kind == 0 ? 3600 + rand() % 7200 : rand() % 86400;
+      scheduler.daily(secondOfDay / 3600, secondOfDay / 60 % 60, secondOfDay % 60);
+      reference.add(secondOfDay, 86400, true);
+    } else if (kind == 3) {
+      const DCF77::time_t due = start + rand() % (DAYS * 86400);
+      scheduler.at(due);
+      reference.add(due, 0, false);
+    } else {
+      const DCF77::time_t first = start + rand() % 7200;
+      const uint32_t period = 60 + rand() % 7200;
+      scheduler.every(first, period);
+      reference.add(first, period, false);
+    }
+    isDaily.push_back(kind < 3);
+  }
+}
+
+bool check(const DCF77::time_t startUtc) {
+  std::unique_ptr<Scheduler<CHECK_EVENTS>> owner(new Scheduler<CHECK_EVENTS>());
+  Scheduler<CHECK_EVENTS>& scheduler = *owner;
+  Reference reference;
+  std::vector<bool> isDaily;
+  schedule(scheduler, reference, startUtc + 3600, isDaily);
+
+  Clock clock(startUtc);
+  std::vector<DCF77::time_t> lastDue(CHECK_EVENTS, 0);
+  size_t fired = 0;
+  for (unsigned t = 0; t < DAYS * 86400; t++) {
+    const DCF77::time_t now = clock.tick();
+    scheduler.mFired.clear();
+    reference.mFired.clear();
+    scheduler.run(now);
+    reference.run(now);
+    std::sort(scheduler.mFired.begin(), scheduler.mFired.end());
+    if (scheduler.mFired != reference.mFired) {
+      printf("error: at %ld the scheduler fired %zu events, the scan %zu\n",
+          static_cast<long>(now), scheduler.mFired.size(), reference.mFired.size());
+      return false;
+    }
+    for (const Fired& f : scheduler.mFired) {
+      if (isDaily[f.first]) {
+        // Once per day, and at the due time except after a jump forward.
+        if ((lastDue[f.first] != 0 && f.second - lastDue[f.first] != 86400)
+            || now - f.second > 3600 + 600 + 3) {
+          printf("error: daily event %u fired at %ld for %ld\n", f.first,
+              static_cast<long>(now), static_cast<long>(f.second));
+          return false;
+        }
+        lastDue[f.first] = f.second;
+      }
+    }
+    fired += scheduler.mFired.size();
+  }
+  for (uint16_t id = 0; id < CHECK_EVENTS; id++) {
+    scheduler.cancel(id);
+  }
+  if (scheduler.size() != 0) {
+    printf("error: events left after cancel\n");
+    return false;
+  }
+  printf("%zu events fired in %u days\n", fired, DAYS);
+  return true;
+}
+
+} // anonymous namespace
+
+int main() {
+  srand(22);
+  if (not check(SPRING) || not check(AUTUMN)) {
+    return EXIT_FAILURE;
+  }
+
+  static Scheduler<BENCH_EVENTS> scheduler;
+  Reference reference;
+  std::vector<bool> isDaily;
+  schedule(scheduler, reference, SPRING + 3600, isDaily);
+  if (scheduler.size() != BENCH_EVENTS) {
+    printf("error: %u events scheduled\n", scheduler.size());
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned TICKS = 3600;
+  DCF77::time_t now = SPRING + 3600;
+  const double nsRun = bench::nsPerOp(TICKS, [&]() {
+    for (unsigned t = 0; t < TICKS; t++) {
+      scheduler.run(now++);
+    }
+    scheduler.mFired.clear();
+  });
+  DCF77::time_t idle = now + 1;
+  const double nsIdle = bench::nsPerOp(TICKS, [&]() {
+    for (unsigned t = 0; t < TICKS; t++) {
+      bench::doNotOptimize(scheduler.run(idle));
+    }
+  });
+  DCF77::time_t scanNow = SPRING + 3600;
+  const double nsScan = bench::nsPerOp(60, [&]() {
+    for (unsigned t = 0; t < 60; t++) {
+      reference.run(scanNow++);
+    }
+    reference.mFired.clear();
+  });
+  bench::report("run() per second, 10000 events", nsRun, "ns/tick");
+  bench::report("run() without due event", nsIdle, "ns/tick");
+  bench::report("linear scan per second", nsScan, "ns/tick");
+  return EXIT_SUCCESS;
+}
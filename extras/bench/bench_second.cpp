@@ -0,0 +1,276 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+/**
+ * Host check and benchmark of the per second callback and the 1PPS
+ * output of DCF77rxStatic. The synthetic signal of signal.h carries
+ * jitter, and in every other minute a few seconds lose their pulse.
+ * The receiver is started in the middle of a minute and polled every
+ * millisecond. Checked are one callback per second, the second of
+ * minute once a frame has been received, the extrapolation of second
+ * 59 and of the lost seconds, their latency and the 1PPS pulses.
+ * Reported is the host CPU time per simulated second with and without
+ * the callback.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+#include "DCF77rxStatic.h"
+#include "bench.h"
+#include "signal.h"
+
+namespace {
+
+constexpr int SECOND_PIN = 2;
+constexpr int PPS_PIN = 5;
+constexpr int PLAIN_PIN = 3;
+constexpr unsigned MINUTES = 20;
+/* 2026-10-25 00:00:00 UTC, the timeline crosses the change to CET. */
+constexpr DCF77::time_t TIMELINE_START = 1792886400;
+constexpr uint64_t START_US = 1000000;
+/* Begin in second 30 of the first minute. */
+constexpr uint64_t BEGIN_US = START_US + 29500000;
+constexpr uint64_t POLL_US = 1000;
+constexpr uint32_t JITTER_US = 5000;
+
+typedef DCF77rxPolicy<DCF77millis, 170, 1200, DCF77_PULSE_QUEUE_SIZE, 0, 0, PPS_PIN> PpsPolicy;
+
+struct Second {
+  uint8_t second;
+  uint32_t systick;
+  bool extrapolated;
+  uint64_t calledUs;
+  int ppsLevel;
+};
+
+class SecondRx : public DCF77rxStatic<SecondRx, SECOND_PIN, PpsPolicy> {
+public:
+  std::vector<Second> mSeconds;
+  /* The number of seconds reported before the first frame. */
+  size_t mFirstFrame = 0;
+  bool mFrameReceived = false;
+
+  void onDCF77FrameReceived(const uint64_t, const uint32_t) {
+    if (not mFrameReceived) {
+      mFrameReceived = true;
+      mFirstFrame = mSeconds.size();
+    }
+  }
+
+  void onDCF77Second(const uint8_t second, const uint32_t systick, const bool extrapolated) {
+    mSeconds.push_back(Second{second, systick, extrapolated, ArduinoHost::now(),
+      ArduinoHost::pinLevel(PPS_PIN)});
+  }
+};
+
+class PlainRx : public DCF77rxStatic<PlainRx, PLAIN_PIN> {
+public:
+  unsigned mFrames = 0;
+
+  void onDCF77FrameReceived(const uint64_t, const uint32_t) {
+    mFrames++;
+  }
+};
+
+struct Pps {
+  uint64_t risingUs;
+  uint64_t fallingUs;
+};
+
+/**
+ * The edges of the timeline, and the time of the mark of every second,
+ * 0 for the seconds without pulse.
+ */
+std::vector<bench::Edge> makeEdges(std::vector<uint64_t>& markUs) {
+  bench::NoiseModel clean;
+  clean.jitterUs = JITTER_US;
+  bench::NoiseModel lossy = clean;
+  lossy.dropoutRate = 0.1;
+  bench::SignalGenerator cleanGenerator(clean, 23);
+  bench::SignalGenerator lossyGenerator(lossy, 29);
+  std::vector<bench::Edge> edges;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    bench::SignalGenerator& generator = m % 2 ? lossyGenerator : cleanGenerator;
+    generator.appendMinute(edges, TIMELINE_START + 60 * m, START_US + m * 60000000ULL);
+  }
+  markUs.assign(MINUTES * 60 + 1, 0);
+  for (const bench::Edge& e : edges) {
+    uint64_t& mark = markUs[(e.us - START_US) / 1000000];
+    if (e.level == LOW && mark == 0) {
+      mark = e.us;
+    }
+  }
+  // Conclude the last minute.
+  const uint64_t end = START_US + MINUTES * 60000000ULL;
+  edges.push_back(bench::Edge{end, LOW});
+  edges.push_back(bench::Edge{end + 100000, HIGH});
+  markUs[MINUTES * 60] = end;
+  edges.erase(edges.begin(), std::find_if(edges.begin(), edges.end(),
+      [](const bench::Edge& e) {return e.us >= BEGIN_US;}));
+  return edges;
+}
+
+/**
+ * Replay the edges on pin and poll the receiver every POLL_US. Records
+ * the pulses of the 1PPS output, if pps is given.
+ *
+ * @return Host nanoseconds per simulated second.
+ */
+template<typename RX> double replay(RX& rx, const int pin, const std::vector<bench::Edge>& edges,
+    std::vector<Pps>* pps) {
+  ArduinoHost::reset();
+  ArduinoHost::setMicros(BEGIN_US);
+  rx.begin();
+  int ppsLevel = LOW;
+  const auto samplePps = [&]() {
+    if (pps != nullptr && ArduinoHost::pinLevel(PPS_PIN) != ppsLevel) {
+      ppsLevel = ArduinoHost::pinLevel(PPS_PIN);
+      if (ppsLevel == HIGH) {
+        pps->push_back(Pps{ArduinoHost::now(), 0});
+      } else if (not pps->empty()) {
+        pps->back().fallingUs = ArduinoHost::now();
+      }
+    }
+  };
+  uint64_t nextPoll = BEGIN_US + POLL_US;
+  const uint64_t end = edges.back().us + 2000000;
+  const uint64_t start = bench::nowNs();
+  size_t next = 0;
+  while (nextPoll <= end) {
+    while (next < edges.size() && edges[next].us <= nextPoll) {
+      ArduinoHost::setMicros(edges[next].us);
+      ArduinoHost::setPinLevel(pin, edges[next].level);
+      samplePps();
+      next++;
+    }
+    ArduinoHost::setMicros(nextPoll);
+    rx.poll();
+    samplePps();
+    nextPoll += POLL_US;
+  }
+  return static_cast<double>(bench::nowNs() - start) / ((end - BEGIN_US) / 1e6);
+}
+
+/**
+ * Checks the reported seconds against the timeline.
+ *
+ * @return The number of errors.
+ */
+unsigned check(const SecondRx& rx, const std::vector<uint64_t>& markUs,
+    const std::vector<Pps>& pps, unsigned& extrapolated, uint64_t& worstLatencyUs) {
+  unsigned errors = 0;
+  const auto fail = [&](const char* what, const size_t i) {
+    if (errors++ < 10) {
+      printf("error: second %zu: %s\n", i, what);
+    }
+  };
+  const std::vector<Second>& seconds = rx.mSeconds;
+  // The first second after begin() is second 30 of the first minute.
+  const size_t first = 30;
+  if (seconds.empty() || seconds.front().second != SecondRx::UNKNOWN_SECOND) {
+    fail("no unknown second before the first minute mark", 0);
+  }
+  extrapolated = 0;
+  worstLatencyUs = 0;
+  for (size_t i = 0; i < seconds.size(); i++) {
+    const Second& s = seconds[i];
+    const size_t n = first + i;
+    const uint64_t nominalUs = START_US + n * 1000000ULL;
+    const uint64_t tickUs = static_cast<uint64_t>(s.systick) * 1000;
+    if (tickUs + 1000 < nominalUs || tickUs > nominalUs + JITTER_US) {
+      fail("systick off the second", n);
+    }
+    // A second is extrapolated one second after the previous one,
+    // unless its mark has been received before.
+    const uint64_t mark = n < markUs.size() ? markUs[n] : 0;
+    if (s.extrapolated && mark != 0 && mark <= s.calledUs) {
+      fail("extrapolated, but marked", n);
+    } else if (not s.extrapolated && mark == 0) {
+      fail("not extrapolated", n);
+    }
+    if (i >= rx.mFirstFrame && s.second != n % 60) {
+      fail("wrong second of minute", n);
+    }
+    if (s.ppsLevel != HIGH) {
+      fail("1PPS output not high", n);
+    }
+    const uint64_t latencyUs = s.calledUs - tickUs;
+    if (s.extrapolated) {
+      extrapolated++;
+      worstLatencyUs = std::max(worstLatencyUs, latencyUs);
+      // Extrapolated exactly one second after the previous one.
+      const uint64_t limitUs = POLL_US + 1000;
+      if (latencyUs > limitUs) {
+        fail("extrapolated late", n);
+      }
+    } else if (latencyUs > 1000) {
+      fail("received second reported late", n);
+    }
+  }
+  // poll() goes on for 2 seconds after the last edge.
+  const size_t expected = markUs.size() + 2 - first;
+  if (seconds.size() != expected) {
+    printf("error: %zu seconds reported, %zu expected\n", seconds.size(), expected);
+    errors++;
+  }
+  if (pps.size() != seconds.size()) {
+    printf("error: %zu 1PPS pulses for %zu seconds\n", pps.size(), seconds.size());
+    errors++;
+  }
+  for (size_t i = 0; i < pps.size() && i < seconds.size(); i++) {
+    const uint64_t widthUs = pps[i].fallingUs - static_cast<uint64_t>(seconds[i].systick) * 1000;
+    if (pps[i].risingUs != seconds[i].calledUs || widthUs < 100000 || widthUs > 100000 + POLL_US) {
+      fail("1PPS pulse", first + i);
+    }
+  }
+  return errors;
+}
+
+} // anonymous namespace
+
+int main() {
+  std::vector<uint64_t> markUs;
+  const std::vector<bench::Edge> edges = makeEdges(markUs);
+
+  SecondRx* secondRx = new SecondRx;
+  std::vector<Pps> pps;
+  const double secondNs = replay(*secondRx, SECOND_PIN, edges, &pps);
+  PlainRx plain;
+  const double plainNs = replay(plain, PLAIN_PIN, edges, nullptr);
+
+  unsigned extrapolated = 0;
+  uint64_t worstLatencyUs = 0;
+  const unsigned errors = check(*secondRx, markUs, pps, extrapolated, worstLatencyUs);
+  printf("%zu seconds, %u extrapolated, worst latency %llu us, %zu 1PPS pulses\n",
+      secondRx->mSeconds.size(), extrapolated,
+      static_cast<unsigned long long>(worstLatencyUs), pps.size());
+  bench::report("receiver, cpu per second", plainNs, "ns");
+  bench::report("receiver + second callback + 1PPS", secondNs, "ns");
+  delete secondRx;
+  if (errors != 0 || plain.mFrames == 0) {
+    printf("error: %u errors\n", errors);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of the devirtualized receiver. DCF77rx calls
+ * the virtual onDCF77FrameReceived(), DCF77rxStatic calls the callback
+ * of the derived class directly. Both must deliver the same frames with
+ * the same system ticks. A third receiver uses a policy with other
+ * thresholds and a larger queue in mode DECODE_IN_POLL.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "bench.h"
+
+namespace {
+
+constexpr int VIRTUAL_PIN = 2;
+constexpr int STATIC_PIN = 3;
+constexpr int POLICY_PIN = 4;
+constexpr unsigned MINUTES = 60;
+
+struct Received {
+  uint64_t frame;
+  uint32_t systick;
+
+  bool operator==(const Received& other) const {
+    return frame == other.frame && systick == other.systick;
+  }
+};
+
+class VirtualRx : public DCF77rx<VIRTUAL_PIN> {
+public:
+  std::vector<Received> mFrames;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mFrames.push_back(Received{dcf77frame, systick});
+  }
+};
+
+class StaticRx : public DCF77rxStatic<StaticRx, STATIC_PIN> {
+public:
+  std::vector<Received> mFrames;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    mFrames.push_back(Received{dcf77frame, systick});
+  }
+};
+
+typedef DCF77rxPolicy<DCF77millis, 150, 1500, 32> TightPolicy;
+
+class PolicyRx : public DCF77rxStatic<PolicyRx, POLICY_PIN, TightPolicy> {
+public:
+  std::vector<Received> mFrames;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    mFrames.push_back(Received{dcf77frame, systick});
+  }
+};
+
+uint64_t randomFrame() {
+  const unsigned year = rand() % 100;
+  const unsigned month = 1 + rand() % 12;
+  const unsigned mday = 1 + rand() % 28;
+  const unsigned wday = 1 + rand() % 7;
+  const unsigned hour = rand() % 24;
+  const unsigned minute = rand() % 60;
+  return bench::encodeFrame(year, month, mday, wday, hour, minute, rand() & 1);
+}
+
+/* Edges with up to 10ms jitter and a few flipped pulse widths. */
+std::vector<bench::Edge> makeEdges() {
+  std::vector<bench::Edge> edges;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    uint64_t frame = randomFrame();
+    if (m % 7 == 3) {
+      frame ^= static_cast<uint64_t>(1) << (21 + rand() % 38);
+    }
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, frame, m * 60000000ULL + 1000000);
+    for (bench::Edge& e : minute) {
+      e.us += rand() % 10000;
+      edges.push_back(e);
+    }
+  }
+  edges.push_back(bench::Edge{MINUTES * 60000000ULL + 1000000, LOW});
+  return edges;
+}
+
+} // anonymous namespace
+
+int main() {
+  srand(14);
+  const std::vector<bench::Edge> edges = makeEdges();
+
+  ArduinoHost::reset();
+  VirtualRx virtualRx;
+  StaticRx staticRx;
+  PolicyRx policyRx;
+  virtualRx.begin();
+  staticRx.begin();
+  policyRx.begin(PolicyRx::DECODE_IN_POLL);
+  for (const bench::Edge& e : edges) {
+    ArduinoHost::setMicros(e.us);
+    ArduinoHost::setPinLevel(VIRTUAL_PIN, e.level);
+    ArduinoHost::setPinLevel(STATIC_PIN, e.level);
+    ArduinoHost::setPinLevel(POLICY_PIN, e.level);
+    policyRx.poll();
+  }
+
+  printf("DCF77rx (virtual)        %3zu frames, %zu bytes\n", virtualRx.mFrames.size(),
+      sizeof(DCF77rx<VIRTUAL_PIN>));
+  printf("DCF77rxStatic            %3zu frames, %zu bytes\n", staticRx.mFrames.size(),
+      sizeof(DCF77rxStatic<StaticRx, STATIC_PIN>));
+  printf("DCF77rxStatic (policy)   %3zu frames, %zu bytes\n", policyRx.mFrames.size(),
+      sizeof(DCF77rxStatic<PolicyRx, POLICY_PIN, TightPolicy>));
+
+  if (staticRx.mFrames.empty() || not (staticRx.mFrames == virtualRx.mFrames)
+      || not (policyRx.mFrames == virtualRx.mFrames) || policyRx.pulseOverflowCount()) {
+    printf("error: the receivers delivered different frames\n");
+    return EXIT_FAILURE;
+  }
+
+  // Time the pin interrupt up to the callback.
+  std::vector<bench::Edge> pulses;
+  for (unsigned m = 0; m < 10; m++) {
+    bench::appendMinute(pulses, randomFrame(), m * 60000000ULL);
+  }
+  ArduinoHost::reset();
+  VirtualRx timedVirtual;
+  StaticRx timedStatic;
+  timedVirtual.begin();
+  timedStatic.begin();
+  uint64_t offset = 0;
+  const double nsVirtual = bench::nsPerOp(pulses.size(), [&]() {
+    bench::replay(pulses, VIRTUAL_PIN, offset);
+    offset += 10 * 60000000ULL;
+  });
+  const double nsStatic = bench::nsPerOp(pulses.size(), [&]() {
+    bench::replay(pulses, STATIC_PIN, offset);
+    offset += 10 * 60000000ULL;
+  });
+  bench::report("pin interrupt (DCF77rx, virtual)", nsVirtual, "ns/pulse");
+  bench::report("pin interrupt (DCF77rxStatic)", nsStatic, "ns/pulse");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check of the receiver instrumentation. Built with
+ * DCF77_INSTRUMENTATION enabled. A pulse train with a known number of
+ * corrupted minutes of each kind is decoded, and the counters must
+ * match exactly. The interrupt handler is timed with the time stamp
+ * counter of the host, the histogram is printed.
+ */
+
+#include <stdlib.h>
+#include <vector>
+
+// The clock for DCF77_ISR_CLOCK must be declared before the receiver.
+#include "bench.h"
+#define DCF77_ISR_CLOCK() static_cast<uint32_t>(bench::cycles())
+
+#include "DCF77rxStatic.h"
+
+#if !DCF77_INSTRUMENTATION
+#error "bench_stats must be built with DCF77_INSTRUMENTATION"
+#endif
+
+namespace {
+
+constexpr int PIN = 2;
+constexpr unsigned MINUTES = 48;
+constexpr uint64_t MINUTE_US = 60000000ULL;
+/* Begin 2s in, so that the first mark is detected as minute mark. */
+constexpr uint64_t START_US = 2000000;
+
+enum KIND {CLEAN, P1, P2, P3, SHORT, LONG};
+constexpr KIND KINDS[] = {CLEAN, P1, CLEAN, P2, CLEAN, P3, CLEAN, SHORT, CLEAN, LONG, CLEAN, CLEAN};
+constexpr unsigned KIND_COUNT = sizeof(KINDS) / sizeof(KINDS[0]);
+
+class Rx : public DCF77rxStatic<Rx, PIN> {
+public:
+  unsigned mFrames = 0;
+
+  void onDCF77FrameReceived(const uint64_t, const uint32_t) {
+    mFrames++;
+  }
+};
+
+} // anonymous namespace
+
+int main() {
+  std::vector<bench::Edge> edges;
+  DCF77decoderStats expected = DCF77decoderStats();
+  // The first minute mark concludes an empty minute.
+  expected.shortFrames = 1;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    uint64_t frame = bench::encodeFrame(25, 6, 1 + m / 60, 7, 12, m % 60, true);
+    const KIND kind = KINDS[m % KIND_COUNT];
+    std::vector<bench::Edge> minute;
+    switch (kind) {
+    case P1:
+      frame ^= static_cast<uint64_t>(1) << 22;
+      expected.p1Errors++;
+      break;
+    case P2:
+      frame ^= static_cast<uint64_t>(1) << 30;
+      expected.p2Errors++;
+      break;
+    case P3:
+      frame ^= static_cast<uint64_t>(1) << 40;
+      expected.p3Errors++;
+      break;
+    default:
+      break;
+    }
+    bench::appendMinute(minute, frame, START_US + m * MINUTE_US);
+    if (kind == SHORT) {
+      // The gap of the missing pulse in second 30 looks like a minute
+      // mark. The minute is split into two short ones.
+      minute.erase(minute.begin() + 60, minute.begin() + 62);
+      expected.shortFrames += 2;
+    } else if (kind == LONG) {
+      // A spurious pulse in second 40.
+      const uint64_t at = minute[80].us + 500000;
+      minute.insert(minute.begin() + 82, bench::Edge{at + 50000, HIGH});
+      minute.insert(minute.begin() + 82, bench::Edge{at, LOW});
+      expected.longFrames++;
+    } else if (kind == CLEAN) {
+      expected.frames++;
+    }
+    expected.bits += minute.size() / 2;
+    edges.insert(edges.end(), minute.begin(), minute.end());
+  }
+  edges.push_back(bench::Edge{START_US + MINUTES * MINUTE_US, LOW});
+
+  ArduinoHost::reset();
+  Rx rx;
+  rx.begin();
+  const uint64_t start = bench::nowNs();
+  bench::replay(edges, PIN);
+  const double nsPerEdge = static_cast<double>(bench::nowNs() - start) / edges.size();
+
+  DCF77rxStats stats;
+  rx.statistics(stats);
+  const DCF77decoderStats& d = stats.decoder;
+  printf("edges %u bits %u frames %u short %u long %u p1 %u p2 %u p3 %u\n",
+      stats.isr.edges, d.bits, d.frames, d.shortFrames, d.longFrames,
+      d.p1Errors, d.p2Errors, d.p3Errors);
+  printf("interrupt handler execution time:\n");
+  for (unsigned bin = 0; bin < DCF77_ISR_HISTOGRAM_BINS; bin++) {
+    const uint32_t from = bin == 0 ? 0 : 1u << (bin - 1);
+    printf("  %5u%s cycles %6u\n", from, bin + 1 == DCF77_ISR_HISTOGRAM_BINS ? "+" : " ",
+        stats.isr.isrTicks[bin]);
+  }
+  bench::report("pin interrupt, instrumented", nsPerEdge, "ns/edge");
+
+  if (stats.isr.edges != edges.size() || d.bits != expected.bits
+      || d.frames != expected.frames || d.frames != rx.mFrames
+      || d.shortFrames != expected.shortFrames || d.longFrames != expected.longFrames
+      || d.p1Errors != expected.p1Errors || d.p2Errors != expected.p2Errors
+      || d.p3Errors != expected.p3Errors) {
+    printf("error: expected edges %zu bits %u frames %u short %u long %u p1 %u p2 %u p3 %u\n",
+        edges.size(), expected.bits, expected.frames, expected.shortFrames,
+        expected.longFrames, expected.p1Errors, expected.p2Errors, expected.p3Errors);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of the edge time sources of DCF77rx. Two
+ * receivers, one with millis() and one with micros(), receive the same
+ * pulses whose edges are not aligned to the millisecond. The run crosses
+ * the wraparound of micros() at 2^32us. The systick at the minute mark
+ * is compared with the true time of the mark.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "DCF77accumulator.h"
+#include "bench.h"
+
+namespace {
+
+constexpr uint8_t PIN_MILLIS = 3;
+constexpr uint8_t PIN_MICROS = 4;
+constexpr unsigned MINUTES = 12;
+constexpr uint64_t MINUTE_US = 60000000ULL;
+/* Start 5 minutes before micros() wraps around. */
+constexpr uint64_t START_US = (static_cast<uint64_t>(1) << 32) - 5 * MINUTE_US;
+
+uint64_t frameOfMinute(unsigned m) {
+  return bench::encodeFrame(25, 3, 1, 6, 10, m, false);
+}
+
+/* The true time of the minute marks in us. */
+std::vector<uint64_t> gMarks;
+
+struct Errors {
+  unsigned frames = 0;
+  unsigned wrong = 0;
+  double sumUs = 0;
+  double maxUs = 0;
+
+  void count(uint64_t dcf77frame, uint32_t systick, uint32_t ticksPerMilli) {
+    // The frame concluded at mark m was sent in minute m - 1.
+    const uint32_t tickUs = 1000 / ticksPerMilli;
+    for (size_t m = 1; m < gMarks.size(); m++) {
+      const uint64_t truth = gMarks[m];
+      const uint32_t truthTicks = static_cast<uint32_t>(truth / tickUs);
+      const uint32_t difference = systick - truthTicks;
+      if (difference < 2 || difference > 0xFFFFFFFE) {
+        // The time source truncates to whole ticks.
+        const double errorUs = fabs(static_cast<double>(truth % tickUs)
+            - static_cast<double>(static_cast<int32_t>(difference)) * tickUs);
+        frames++;
+        wrong += dcf77frame != frameOfMinute(m - 1) || difference != 0;
+        sumUs += errorUs;
+        maxUs = errorUs > maxUs ? errorUs : maxUs;
+        return;
+      }
+    }
+    wrong++;
+  }
+};
+
+class MillisRx : public DCF77rx<PIN_MILLIS> {
+public:
+  Errors mErrors;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mErrors.count(dcf77frame, systick, DCF77millis::TICKS_PER_MILLI);
+  }
+};
+
+class MicrosRx : public DCF77rx<PIN_MICROS, DCF77micros> {
+public:
+  Errors mErrors;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mErrors.count(dcf77frame, systick, DCF77micros::TICKS_PER_MILLI);
+  }
+};
+
+class MicrosAccumulator : public DCF77accumulator {
+public:
+  Errors mErrors;
+private:
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+    mErrors.count(dcf77frame, systick, DCF77micros::TICKS_PER_MILLI);
+  }
+};
+
+struct PinEdge {
+  uint64_t us;
+  int level;
+};
+
+void report(const char* name, const Errors& e) {
+  printf("%-28s %3u frames %3u wrong, mark error mean %7.1f us max %7.1f us\n",
+      name, e.frames, e.wrong, e.frames ? e.sumUs / e.frames : 0.0, e.maxUs);
+}
+
+} // anonymous namespace
+
+int main() {
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<uint32_t> subMilli(1, 999);
+
+  ArduinoHost::reset();
+  MillisRx millisRx;
+  MicrosRx microsRx;
+  MicrosAccumulator accumulator;
+  microsRx.attachAccumulator(accumulator);
+  millisRx.begin();
+  microsRx.begin();
+
+  // Every edge is shifted by a random fraction of a millisecond.
+  std::vector<bench::Edge> edges;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, frameOfMinute(m), START_US + m * MINUTE_US);
+    for (bench::Edge& e : minute) {
+      e.us += subMilli(rng);
+      edges.push_back(e);
+    }
+    gMarks.push_back(minute.front().us);
+  }
+  gMarks.push_back(START_US + MINUTES * MINUTE_US + subMilli(rng));
+  edges.push_back(bench::Edge{gMarks.back(), LOW});
+
+  for (const bench::Edge& e : edges) {
+    ArduinoHost::setMicros(e.us);
+    ArduinoHost::setPinLevel(PIN_MILLIS, e.level);
+    ArduinoHost::setPinLevel(PIN_MICROS, e.level);
+  }
+
+  report("DCF77rx<PIN> (millis)", millisRx.mErrors);
+  report("DCF77rx<PIN, DCF77micros>", microsRx.mErrors);
+  report("DCF77accumulator (micros)", accumulator.mErrors);
+
+  // Time the pin interrupt for both time sources.
+  std::vector<bench::Edge> pulses;
+  for (unsigned m = 0; m < 10; m++) {
+    bench::appendMinute(pulses, frameOfMinute(m), m * MINUTE_US);
+  }
+  ArduinoHost::reset();
+  MillisRx timedMillis;
+  MicrosRx timedMicros;
+  timedMillis.begin();
+  timedMicros.begin();
+  uint64_t offset = 0;
+  const double nsMillis = bench::nsPerOp(pulses.size(), [&]() {
+    bench::replay(pulses, PIN_MILLIS, offset);
+    offset += 10 * MINUTE_US;
+  });
+  const double nsMicros = bench::nsPerOp(pulses.size(), [&]() {
+    bench::replay(pulses, PIN_MICROS, offset);
+    offset += 10 * MINUTE_US;
+  });
+  bench::report("pin interrupt (millis)", nsMillis, "ns/pulse");
+  bench::report("pin interrupt (micros)", nsMicros, "ns/pulse");
+
+  // All minutes but the first must be received, the micros time stamps
+  // must be exact.
+  if (millisRx.mErrors.frames < MINUTES - 1 || millisRx.mErrors.maxUs >= 1000
+      || microsRx.mErrors.frames < MINUTES - 1 || microsRx.mErrors.wrong
+      || microsRx.mErrors.maxUs != 0 || accumulator.mErrors.frames == 0
+      || accumulator.mErrors.wrong) {
+    printf("error: time stamps or frames don't match\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host check and benchmark of the pulse trace. Six hours of signal are
+ * recorded by a live receiver, dumped as text, read back and replayed
+ * through a second receiver, which must deliver the same frames. A
+ * small ring must hold the latest minutes after it has wrapped.
+ */
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "DCF77trace.h"
+#include "DCF77replay.h"
+#include "bench.h"
+
+namespace {
+
+constexpr int LIVE_PIN = 2;
+constexpr int RING_PIN = 3;
+constexpr int MICROS_PIN = 4;
+constexpr int REPLAY_PIN = 5;
+constexpr unsigned MINUTES = 360;
+
+struct Received {
+  uint64_t frame;
+  uint32_t systick;
+
+  bool operator==(const Received& other) const {
+    return frame == other.frame && systick == other.systick;
+  }
+};
+
+template<int PIN, typename TIMESOURCE> class Rx
+    : public DCF77rxStatic<Rx<PIN, TIMESOURCE>, PIN, DCF77rxPolicy<TIMESOURCE>> {
+public:
+  std::vector<Received> mFrames;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    mFrames.push_back(Received{dcf77frame, systick});
+  }
+};
+
+class StringPrint : public Print {
+public:
+  std::string mText;
+
+  size_t write(uint8_t c) override {
+    mText.push_back(static_cast<char>(c));
+    return 1;
+  }
+  using Print::write;
+};
+
+DCF77traceBuffer<128 * 1024> liveTrace;
+DCF77traceBuffer<1024> ringTrace;
+DCF77traceBuffer<192 * 1024> microsTrace;
+
+uint64_t randomFrame() {
+  const unsigned year = rand() % 100;
+  const unsigned month = 1 + rand() % 12;
+  const unsigned mday = 1 + rand() % 28;
+  const unsigned wday = 1 + rand() % 7;
+  const unsigned hour = rand() % 24;
+  const unsigned minute = rand() % 60;
+  return bench::encodeFrame(year, month, mday, wday, hour, minute, rand() & 1);
+}
+
+/* Edges with up to 10ms jitter and a spike, that breaks the minute, every
+   13 minutes. */
+std::vector<bench::Edge> makeEdges() {
+  std::vector<bench::Edge> edges;
+  for (unsigned m = 0; m < MINUTES; m++) {
+    std::vector<bench::Edge> minute;
+    bench::appendMinute(minute, randomFrame(), m * 60000000ULL + 1000000);
+    for (bench::Edge& e : minute) {
+      e.us += rand() % 10000;
+    }
+    if (m % 13 == 5) {
+      const size_t i = 2 * (rand() % 58) + 1;
+      const uint64_t at = minute[i].us + 300000;
+      minute.insert(minute.begin() + i + 1, {bench::Edge{at, LOW}, bench::Edge{at + 3000, HIGH}});
+    }
+    edges.insert(edges.end(), minute.begin(), minute.end());
+  }
+  edges.push_back(bench::Edge{MINUTES * 60000000ULL + 1000000, LOW});
+  return edges;
+}
+
+template<typename RX> bool roundTrip(DCF77trace& trace, const std::vector<Received>& live,
+    std::vector<Received>& replayed, replay::Trace& parsed) {
+  StringPrint dump;
+  trace.dump(dump);
+  if (not replay::parse(dump.mText, parsed)) {
+    printf("error: the dump can't be parsed\n");
+    return false;
+  }
+  RX rx;
+  const size_t edges = replay::replay(parsed, rx);
+  replayed = rx.mFrames;
+  if (edges != trace.edgeCount() || edges != parsed.edges) {
+    printf("error: %zu edges replayed, %zu recorded\n", edges, trace.edgeCount());
+    return false;
+  }
+  // The replay of a wrapped ring starts within the recording.
+  if (replayed.empty() || replayed.size() > live.size()
+      || not std::equal(replayed.begin(), replayed.end(), live.end() - replayed.size())) {
+    printf("error: the replay delivered other frames than the live receiver\n");
+    return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main() {
+  srand(18);
+  const std::vector<bench::Edge> edges = makeEdges();
+
+  typedef Rx<LIVE_PIN, DCF77millis> LiveRx;
+  typedef Rx<RING_PIN, DCF77millis> RingRx;
+  typedef Rx<MICROS_PIN, DCF77micros> MicrosRx;
+  typedef Rx<REPLAY_PIN, DCF77millis> ReplayRx;
+  typedef Rx<REPLAY_PIN, DCF77micros> ReplayMicrosRx;
+
+  ArduinoHost::reset();
+  LiveRx liveRx;
+  RingRx ringRx;
+  MicrosRx microsRx;
+  liveRx.attachTrace(liveTrace);
+  ringRx.attachTrace(ringTrace);
+  microsRx.attachTrace(microsTrace);
+  liveRx.begin();
+  ringRx.begin();
+  microsRx.begin();
+  for (const bench::Edge& e : edges) {
+    ArduinoHost::setMicros(e.us);
+    ArduinoHost::setPinLevel(LIVE_PIN, e.level);
+    ArduinoHost::setPinLevel(RING_PIN, e.level);
+    ArduinoHost::setPinLevel(MICROS_PIN, e.level);
+  }
+
+  std::vector<Received> replayed;
+  replay::Trace parsed;
+  if (liveRx.mFrames.size() < MINUTES * 9 / 10 || liveTrace.droppedCount() != 0
+      || liveTrace.edgeCount() != edges.size()
+      || not roundTrip<ReplayRx>(liveTrace, liveRx.mFrames, replayed, parsed)
+      || replayed.size() != liveRx.mFrames.size()) {
+    printf("error: the replay of the full trace differs\n");
+    return EXIT_FAILURE;
+  }
+  printf("live                %3zu frames, %zu edges, %.2f bytes/edge\n",
+      liveRx.mFrames.size(), liveTrace.edgeCount(),
+      static_cast<double>(liveTrace.byteCount()) / liveTrace.edgeCount());
+
+  std::vector<Received> ringReplayed;
+  replay::Trace ringParsed;
+  if (ringTrace.droppedCount() == 0
+      || not roundTrip<ReplayRx>(ringTrace, ringRx.mFrames, ringReplayed, ringParsed)
+      || ringReplayed.size() < 3) {
+    printf("error: the replay of the wrapped ring differs\n");
+    return EXIT_FAILURE;
+  }
+  printf("ring of 1kB         %3zu frames, %zu edges, %.2f bytes/edge\n",
+      ringReplayed.size(), ringTrace.edgeCount(),
+      static_cast<double>(ringTrace.byteCount()) / ringTrace.edgeCount());
+
+  std::vector<Received> microsReplayed;
+  replay::Trace microsParsed;
+  if (not roundTrip<ReplayMicrosRx>(microsTrace, microsRx.mFrames, microsReplayed, microsParsed)
+      || microsReplayed.size() != microsRx.mFrames.size()) {
+    printf("error: the replay of the micros() trace differs\n");
+    return EXIT_FAILURE;
+  }
+  printf("micros()            %3zu frames, %zu edges, %.2f bytes/edge\n",
+      microsReplayed.size(), microsTrace.edgeCount(),
+      static_cast<double>(microsTrace.byteCount()) / microsTrace.edgeCount());
+
+  // Record cost in the interrupt handler, with the ring wrapping.
+  uint32_t time = 0;
+  int level = LOW;
+  const double nsRecord = bench::nsPerOp(100000, [&]() {
+    for (int i = 0; i < 100000; i++) {
+      time += level == LOW ? 100 : 900;
+      ringTrace.record(level, time);
+      level = level == LOW ? HIGH : LOW;
+    }
+  });
+  bench::report("record an edge", nsRecord, "ns/edge");
+
+  const double nsReplay = bench::nsPerOp(parsed.edges, [&]() {
+    ReplayRx rx;
+    bench::doNotOptimize(replay::replay(parsed, rx));
+  });
+  bench::report("replay through the decoder", nsReplay, "ns/edge");
+  const double replayMs = nsReplay * parsed.edges / 1e6;
+  bench::report("six hours of signal replayed in", replayMs, "ms");
+  return EXIT_SUCCESS;
+}
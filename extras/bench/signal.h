@@ -0,0 +1,188 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Synthetic DCF77 signal for the host benchmarks. A UTC timeline is
+ * encoded into the pulse edges of the receiver output, the inverse of
+ * dcf77frame2time(), and disturbed by the noise models of NoiseModel.
+ */
+
+#pragma once
+
+#ifndef DCF77_BENCH_SIGNAL_H_
+#define DCF77_BENCH_SIGNAL_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DCF77rxtm.h"
+#include "internal/DCF77calendar.h"
+#include "internal/DCF77frame.h"
+#include "bench.h"
+
+namespace bench {
+
+/**
+ * The disturbances of the receiver output. All of them are off by
+ * default, which yields the ideal signal.
+ */
+struct NoiseModel {
+  /* Every edge is delayed by up to this. */
+  uint32_t jitterUs = 0;
+  /* Short pulses of the opposite level, e.g. from switching power supplies. */
+  double spikesPerSecond = 0;
+  uint32_t spikeUs = 3000;
+  /* Probability that the pulse of a second is missing. */
+  double dropoutRate = 0;
+  /* Probability that a fade starts in a second. During a fade, the
+     pulse widths are off by up to fadeDistortionUs and half of the
+     pulses are missing. */
+  double fadeRate = 0;
+  uint32_t fadeSeconds = 10;
+  uint32_t fadeDistortionUs = 60000;
+};
+
+/**
+ * CEST is in effect from the last Sunday of March to the last Sunday
+ * of October, 01:00 UTC each.
+ */
+inline bool isCest(const DCF77::time_t utc) {
+  uint32_t secondOfDay;
+  const uint32_t days = DCF77calendar::days_from_timestamp(utc, secondOfDay);
+  const uint16_t year = DCF77calendar::civil_from_days(days).year;
+  const uint32_t march31 = DCF77calendar::days_from_civil(year, 3, 31);
+  const uint32_t october31 = DCF77calendar::days_from_civil(year, 10, 31);
+  const uint32_t begin = (march31 - DCF77calendar::civil_from_days(march31).wday)
+      * DCF77calendar::SECS_PER_DAY + 3600;
+  const uint32_t end = (october31 - DCF77calendar::civil_from_days(october31).wday)
+      * DCF77calendar::SECS_PER_DAY + 3600;
+  return utc >= begin && utc < end;
+}
+
+/**
+ * The frame that is transmitted in the minute that starts at utc. It
+ * announces the following minute. A1 is set within the hour before a
+ * change between CET and CEST.
+ */
+inline uint64_t frameOfMinute(const DCF77::time_t utc) {
+  const DCF77::time_t announced = utc + 60;
+  const bool cest = isCest(announced);
+  DCF77::tm local;
+  DCF77::timestamp_to_tm(local, announced + (cest ? 7200 : 3600), cest);
+  uint64_t frame = DCF77rxbase::dcf77time2frame(local);
+  if (isCest(announced + 3600) != cest) {
+    frame |= DCF77frame::A1::insert(1);
+  }
+  return frame;
+}
+
+/**
+ * Produces the disturbed pulse train of a UTC timeline.
+ */
+class SignalGenerator {
+public:
+  SignalGenerator(const NoiseModel& noise, uint32_t seed)
+    : mNoise(noise), mRandom(seed) {
+  }
+
+  /**
+   * Append the edges of the minute that starts at utc.
+   *
+   * @param utc The UTC time stamp of the minute, a multiple of 60.
+   * @param startUs The time of the second 0 mark in microseconds.
+   * @return The transmitted frame.
+   */
+  uint64_t appendMinute(std::vector<Edge>& edges, const DCF77::time_t utc,
+      const uint64_t startUs) {
+    const uint64_t frame = frameOfMinute(utc);
+    std::vector<Edge> minute;
+    for (unsigned sec = 0; sec < 60; sec++) {
+      const uint64_t mark = startUs + sec * 1000000ULL;
+      if (mFadeLeft == 0 && chance(mNoise.fadeRate)) {
+        mFadeLeft = mNoise.fadeSeconds;
+      }
+      const bool fading = mFadeLeft != 0;
+      if (fading) {
+        mFadeLeft--;
+      }
+
+      int64_t width = (frame >> sec) & 1 ? 200000 : 100000;
+      bool pulse = sec < 59 && not chance(mNoise.dropoutRate);
+      if (fading) {
+        pulse = pulse && chance(0.5);
+        width += uniform(2 * mNoise.fadeDistortionUs + 1) - mNoise.fadeDistortionUs;
+        width = std::max<int64_t>(width, 10000);
+      }
+      if (pulse) {
+        minute.push_back(Edge{mark + uniform(mNoise.jitterUs), LOW});
+        minute.push_back(Edge{mark + width + uniform(mNoise.jitterUs), HIGH});
+      }
+      appendSpikes(minute, mark, pulse ? width : 0);
+    }
+    std::stable_sort(minute.begin(), minute.end(),
+        [](const Edge& a, const Edge& b) {return a.us < b.us;});
+    edges.insert(edges.end(), minute.begin(), minute.end());
+    return frame;
+  }
+
+private:
+  bool chance(const double probability) {
+    return probability > 0 && std::uniform_real_distribution<double>(0, 1)(mRandom) < probability;
+  }
+
+  uint64_t uniform(const uint64_t range) {
+    return range != 0 ? std::uniform_int_distribution<uint64_t>(0, range - 1)(mRandom) : 0;
+  }
+
+  /* Spikes that don't overlap the pulse edges of the second. */
+  void appendSpikes(std::vector<Edge>& edges, const uint64_t mark, const uint64_t width) {
+    if (mNoise.spikesPerSecond <= 0) {
+      return;
+    }
+    const uint64_t guard = mNoise.spikeUs + mNoise.jitterUs;
+    for (unsigned n = std::poisson_distribution<unsigned>(mNoise.spikesPerSecond)(mRandom);
+        n > 0; n--) {
+      const uint64_t offset = uniform(1000000 - guard);
+      if (offset + guard > width && offset < width + guard) {
+        continue;
+      }
+      if (offset < guard) {
+        continue;
+      }
+      const int level = offset < width ? LOW : HIGH;
+      edges.push_back(Edge{mark + offset, level == LOW ? HIGH : LOW});
+      edges.push_back(Edge{mark + offset + mNoise.spikeUs, level});
+    }
+  }
+
+  NoiseModel mNoise;
+  std::mt19937 mRandom;
+  uint32_t mFadeLeft = 0;
+};
+
+} // namespace bench
+
+#endif /* DCF77_BENCH_SIGNAL_H_ */
@@ -0,0 +1,194 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "Arduino.h"
+
+#include <stdio.h>
+
+HostSerial Serial;
+
+namespace {
+
+struct PinState {
+  int level = HIGH;
+  uint8_t mode = INPUT;
+  void (*handler)() = nullptr;
+  int trigger = CHANGE;
+};
+
+PinState pins[ARDUINO_HOST_NUM_PINS];
+uint64_t simulatedMicros = 0;
+bool interruptsEnabled = true;
+
+size_t printNumber(Print& p, unsigned long long v, int base) {
+  char buf[8 * sizeof(v) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) {
+    base = 10;
+  }
+  do {
+    const unsigned digit = v % base;
+    v /= base;
+    *--str = static_cast<char>(digit < 10 ? digit + '0' : digit + 'A' - 10);
+  } while (v);
+  return p.print(str);
+}
+
+} // anonymous namespace
+
+size_t Print::print(long v, int base) {
+  return print(static_cast<long long>(v), base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  return printNumber(*this, v, base);
+}
+
+size_t Print::print(long long v, int base) {
+  if (base == 10 && v < 0) {
+    const size_t n = print('-');
+    return n + printNumber(*this, -static_cast<unsigned long long>(v), base);
+  }
+  return printNumber(*this, static_cast<unsigned long long>(v), base);
+}
+
+size_t Print::print(unsigned long long v, int base) {
+  return printNumber(*this, v, base);
+}
+
+size_t Print::print(double v, int digits) {
+  char buf[64];
+  const int n = snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return n > 0 ? write(buf, static_cast<size_t>(n)) : 0;
+}
+
+size_t HostSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+uint32_t millis() {
+  return static_cast<uint32_t>(simulatedMicros / 1000);
+}
+
+uint32_t micros() {
+  return static_cast<uint32_t>(simulatedMicros);
+}
+
+void delay(uint32_t ms) {
+  simulatedMicros += static_cast<uint64_t>(ms) * 1000;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < ARDUINO_HOST_NUM_PINS) {
+    pins[pin].mode = mode;
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < ARDUINO_HOST_NUM_PINS ? pins[pin].level : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+  if (pin < ARDUINO_HOST_NUM_PINS) {
+    pins[pin].level = level ? HIGH : LOW;
+  }
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*handler)(), int mode) {
+  if (interruptNum < ARDUINO_HOST_NUM_PINS) {
+    pins[interruptNum].handler = handler;
+    pins[interruptNum].trigger = mode;
+  }
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+  if (interruptNum < ARDUINO_HOST_NUM_PINS) {
+    pins[interruptNum].handler = nullptr;
+  }
+}
+
+void noInterrupts() {
+  interruptsEnabled = false;
+}
+
+void interrupts() {
+  interruptsEnabled = true;
+}
+
+namespace ArduinoHost {
+
+void reset() {
+  for (size_t i = 0; i < ARDUINO_HOST_NUM_PINS; i++) {
+    pins[i] = PinState();
+  }
+  simulatedMicros = 0;
+  interruptsEnabled = true;
+}
+
+void setMicros(uint64_t us) {
+  simulatedMicros = us;
+}
+
+void advanceMicros(uint64_t us) {
+  simulatedMicros += us;
+}
+
+uint64_t now() {
+  return simulatedMicros;
+}
+
+void setPinLevel(uint8_t pin, int level) {
+  if (pin >= ARDUINO_HOST_NUM_PINS) {
+    return;
+  }
+  PinState& state = pins[pin];
+  level = level ? HIGH : LOW;
+  if (state.level == level) {
+    return;
+  }
+  state.level = level;
+  if (state.handler && interruptsEnabled) {
+    const bool fire = state.trigger == CHANGE
+        || (state.trigger == RISING && level == HIGH)
+        || (state.trigger == FALLING && level == LOW);
+    if (fire) {
+      state.handler();
+    }
+  }
+}
+
+int pinLevel(uint8_t pin) {
+  return digitalRead(pin);
+}
+
+bool isAttached(uint8_t pin) {
+  return pin < ARDUINO_HOST_NUM_PINS && pins[pin].handler != nullptr;
+}
+
+} // namespace ArduinoHost
@@ -0,0 +1,119 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Minimal host stand-in for the Arduino core. It allows to compile the
+ * library on an ordinary Linux box, so that the decoder can be profiled
+ * and regression tested without flashing a board.
+ *
+ * Time and pin levels are simulated. A host program drives them through
+ * the ArduinoHost namespace below. Changing a pin level invokes the
+ * interrupt handler attached to that pin, exactly as a CHANGE, RISING or
+ * FALLING interrupt would on the target.
+ */
+
+#pragma once
+
+#ifndef DCF77_HOST_ARDUINO_H_
+#define DCF77_HOST_ARDUINO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Print.h"
+#include "Printable.h"
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define LED_BUILTIN 13
+
+#define NOT_AN_INTERRUPT -1
+#define ARDUINO_HOST_NUM_PINS 64
+#define digitalPinToInterrupt(p) ((p) < ARDUINO_HOST_NUM_PINS ? (p) : NOT_AN_INTERRUPT)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+
+void attachInterrupt(uint8_t interruptNum, void (*handler)(), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+void noInterrupts();
+void interrupts();
+
+class HostSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  explicit operator bool() const {return true;}
+};
+
+extern HostSerial Serial;
+
+/**
+ * Simulation control for host programs.
+ */
+namespace ArduinoHost {
+  /** Reset time, pin levels and interrupt handlers. */
+  void reset();
+
+  /** Set the simulated time in microseconds since start. */
+  void setMicros(uint64_t us);
+
+  /** Advance the simulated time by us microseconds. */
+  void advanceMicros(uint64_t us);
+
+  /** Simulated time in microseconds without 32-bit wrap around. */
+  uint64_t now();
+
+  /**
+   * Drive an input pin to level. Invokes the attached interrupt handler,
+   * if the level change matches its trigger mode and interrupts are
+   * enabled.
+   */
+  void setPinLevel(uint8_t pin, int level);
+
+  /** Level of a pin, as last set by setPinLevel() or digitalWrite(). */
+  int pinLevel(uint8_t pin);
+
+  /** Whether an interrupt handler is attached to the pin. */
+  bool isAttached(uint8_t pin);
+}
+
+#endif /* DCF77_HOST_ARDUINO_H_ */
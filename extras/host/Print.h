@@ -0,0 +1,85 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host stand-in for the Arduino core Print class. Only the subset used
+ * by this library and its host tools is provided.
+ */
+
+#pragma once
+
+#ifndef DCF77_HOST_PRINT_H_
+#define DCF77_HOST_PRINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Printable.h"
+
+#define DEC 10
+#define HEX 16
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+      n += write(*buffer++);
+    }
+    return n;
+  }
+
+  size_t write(const char *buffer, size_t size) {
+    return write(reinterpret_cast<const uint8_t*>(buffer), size);
+  }
+
+  size_t print(const char s[]) {return write(s, strlen(s));}
+  size_t print(char c) {return write(static_cast<uint8_t>(c));}
+  size_t print(unsigned char v, int base = DEC) {return print(static_cast<unsigned long>(v), base);}
+  size_t print(int v, int base = DEC) {return print(static_cast<long>(v), base);}
+  size_t print(unsigned int v, int base = DEC) {return print(static_cast<unsigned long>(v), base);}
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(long long v, int base = DEC);
+  size_t print(unsigned long long v, int base = DEC);
+  size_t print(double v, int digits = 2);
+  size_t print(const Printable& x) {return x.printTo(*this);}
+
+  size_t println() {return write("\r\n", 2);}
+  template<typename T> size_t println(const T& v) {
+    const size_t n = print(v);
+    return n + println();
+  }
+  template<typename T> size_t println(const T& v, int format) {
+    const size_t n = print(v, format);
+    return n + println();
+  }
+};
+
+#endif /* DCF77_HOST_PRINT_H_ */
@@ -0,0 +1,138 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Host helpers to read back a DCF77trace dump and to replay it through
+ * a receiver as fast as possible. The edges are passed directly to
+ * onPinInterrupt(), the simulated clock is only set once before
+ * begin().
+ */
+
+#pragma once
+
+#ifndef DCF77_REPLAY_H_
+#define DCF77_REPLAY_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include "DCF77trace.h"
+
+namespace replay {
+
+struct Trace {
+  unsigned long ticksPerMilli = 1;
+  unsigned long baseTime = 0;
+  unsigned long edges = 0;
+  unsigned long dropped = 0;
+  std::vector<uint8_t> bytes;
+};
+
+inline int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+/**
+ * Parse the first dump in text. Anything before the header line is
+ * skipped, e.g. other output of the sketch on the serial line.
+ *
+ * @return false, if there is no complete dump.
+ */
+inline bool parse(const std::string& text, Trace& trace) {
+  const size_t header = text.find("DCF77TRACE ");
+  if (header == std::string::npos) {
+    return false;
+  }
+  unsigned version = 0;
+  if (sscanf(text.c_str() + header, "DCF77TRACE %u %lu %lu %lu %lu", &version,
+      &trace.ticksPerMilli, &trace.baseTime, &trace.edges, &trace.dropped) != 5
+      || version != 1 || trace.ticksPerMilli == 0) {
+    return false;
+  }
+  trace.bytes.clear();
+  size_t position = text.find('\n', header);
+  while (position != std::string::npos) {
+    position++;
+    const size_t end = text.find('\n', position);
+    std::string line = text.substr(position, end == std::string::npos ? std::string::npos : end - position);
+    while (not line.empty() && (line.back() == '\r' || line.back() == ' ')) {
+      line.pop_back();
+    }
+    if (line == "END") {
+      return true;
+    }
+    if (line.size() % 2 != 0) {
+      return false;
+    }
+    for (size_t i = 0; i < line.size(); i += 2) {
+      const int high = hexValue(line[i]);
+      const int low = hexValue(line[i + 1]);
+      if (high < 0 || low < 0) {
+        return false;
+      }
+      trace.bytes.push_back(static_cast<uint8_t>(high << 4 | low));
+    }
+    position = end;
+  }
+  return false;
+}
+
+/**
+ * Pass all edges of trace to rx. rx must use a time source with
+ * trace.ticksPerMilli ticks per millisecond and must not have been
+ * begun yet.
+ *
+ * @return The number of edges.
+ */
+template<typename RX> size_t replay(const Trace& trace, RX& rx) {
+  // The receiver takes the time of begin() as the previous edge.
+  ArduinoHost::setMicros(static_cast<uint64_t>(trace.baseTime) * 1000 / trace.ticksPerMilli);
+  rx.begin();
+  DCF77traceReader reader(trace.bytes.data(), trace.bytes.size(), trace.baseTime);
+  size_t count = 0;
+  int level;
+  uint32_t time;
+  while (reader.next(level, time)) {
+    rx.onPinInterrupt(level, time);
+    count++;
+  }
+  return count;
+}
+
+} // namespace replay
+
+#endif /* DCF77_REPLAY_H_ */
@@ -0,0 +1,123 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/**
+ * Replay a DCF77trace dump through the decoder.
+ *
+ *   dcf77replay [-q] [trace file]
+ *
+ * Reads the dump from the file or from stdin, e.g. a capture of the
+ * serial monitor, and prints every decoded frame with its system tick,
+ * followed by the decoding time. -q prints the summary only.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+
+#include "DCF77rxtm.h"
+#include "DCF77replay.h"
+
+namespace {
+
+constexpr int REPLAY_PIN = 2;
+
+bool gQuiet = false;
+
+template<typename TIMESOURCE> class ReplayRx
+    : public DCF77rxStatic<ReplayRx<TIMESOURCE>, REPLAY_PIN, DCF77rxPolicy<TIMESOURCE>> {
+public:
+  size_t mFrames = 0;
+
+  void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+    mFrames++;
+    if (gQuiet) {
+      return;
+    }
+    PrintableDCF77tm time;
+    DCF77rxbase::dcf77frame2time(time, dcf77frame);
+    Serial.print(static_cast<unsigned long>(systick));
+    Serial.print(' ');
+    Serial.println(time);
+  }
+};
+
+template<typename TIMESOURCE> int run(const replay::Trace& trace) {
+  ReplayRx<TIMESOURCE> rx;
+  const auto start = std::chrono::steady_clock::now();
+  const size_t edges = replay::replay(trace, rx);
+  const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  printf("%zu edges, %zu frames, %lu edges dropped by the recorder, decoded in %.3f ms\n",
+      edges, rx.mFrames, trace.dropped, seconds * 1e3);
+  return edges == trace.edges ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  const char* path = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-q") == 0) {
+      gQuiet = true;
+    } else {
+      path = argv[i];
+    }
+  }
+
+  FILE* file = path != nullptr ? fopen(path, "r") : stdin;
+  if (file == nullptr) {
+    fprintf(stderr, "dcf77replay: cannot open %s\n", path);
+    return EXIT_FAILURE;
+  }
+  std::string text;
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    text.append(buffer, n);
+  }
+  if (file != stdin) {
+    fclose(file);
+  }
+
+  replay::Trace trace;
+  if (not replay::parse(text, trace)) {
+    fprintf(stderr, "dcf77replay: no complete DCF77TRACE dump found\n");
+    return EXIT_FAILURE;
+  }
+
+  ArduinoHost::reset();
+  switch (trace.ticksPerMilli) {
+  case DCF77millis::TICKS_PER_MILLI:
+    return run<DCF77millis>(trace);
+  case DCF77micros::TICKS_PER_MILLI:
+    return run<DCF77micros>(trace);
+  default:
+    fprintf(stderr, "dcf77replay: unsupported time source with %lu ticks per ms\n",
+        trace.ticksPerMilli);
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,169 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77accumulator_H_
+#define DCF77accumulator_H_
+
+#include <stdint.h>
+#include "DCF77rxtm.h"
+#include "internal/ISR_ATTR.h"
+#include "internal/DCF77frame.h"
+
+/**
+ * DCF77accumulator finds the time from a weak signal, where hardly any
+ * minute is received without a parity error.
+ *
+ * The minute, hour and date sections of the frame are protected by their
+ * own parity bits. A section that passes its check is kept, even if the
+ * others fail. Once all of them have been seen, in the same or in
+ * different minutes, they are combined to a candidate time.
+ *
+ * From then on the frame of every minute is predicted from the candidate,
+ * including the carry into hour and date and the CET / CEST change that
+ * is announced by bit A1. Each predictable bit of the received minute is
+ * compared with the prediction. The candidate is locked, when every bit
+ * has agreed more often than disagreed by lockThreshold. The sections
+ * the candidate was assembled from count as the first agreement. While locked,
+ * the predicted frame is delivered every minute, even if the minute
+ * couldn't be received. A bit that keeps disagreeing discards the
+ * candidate together with the section the bit belongs to.
+ *
+ * Usage:
+ *
+ * class MyAccumulator : public DCF77accumulator {
+ *   // Same signature as DCF77rx::onDCF77FrameReceived().
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     ...
+ *   }
+ * };
+ *
+ * MyAccumulator accumulator;
+ * MyDcf77Receiver receiver;
+ *
+ * void setup() {
+ *   receiver.attachAccumulator(accumulator);
+ *   receiver.begin();
+ * }
+ *
+ * The accumulator runs in the context of the receiver's decoder. Minutes
+ * with more than 59 bits are skipped, which includes the minute with a
+ * leap second. The prediction continues across them.
+ *
+ * A lost pulse looks like a minute mark to the receiver, or shifts the
+ * mark by whole seconds. A minute mark, that isn't within 500ms of a
+ * whole number of minutes after the previous one, is therefore ignored.
+ * The accumulator only moves to a new grid of minute marks, e.g. after
+ * a spurious first mark or a drift of systick, once two marks agree
+ * with each other and the latter ends a minute of 59 bits.
+ */
+class DCF77accumulator {
+public:
+  /** Limits of the agreement score of a bit. */
+  static constexpr int8_t MAX_SCORE = 4;
+  static constexpr int8_t DISCARD_SCORE = -2;
+
+  /**
+   * @param[in] lockThreshold The agreement score every bit must reach
+   *  for lock, within 1 and MAX_SCORE. With the default of 2, one
+   *  minute without error confirms a candidate.
+   */
+  explicit DCF77accumulator(uint8_t lockThreshold = 2);
+
+  /**
+   * Called by a receiver at every minute mark.
+   *
+   * @param[in] bits The bits received in the past minute.
+   * @param[in] bitCount The number of bits received in the past minute.
+   * @param[in] systick The system tick at the minute mark.
+   * @param[in] ticksPerMilli The resolution of systick. Minute marks
+   *  can only be bridged within the wraparound period of systick, e.g.
+   *  71 minutes for micros().
+   */
+  TEXT_ISR_ATTR_3
+  void onMinuteSync(const uint64_t bits, const size_t bitCount, const uint32_t systick,
+      const uint16_t ticksPerMilli = 1);
+
+  /**
+   * Whether predicted frames are delivered.
+   */
+  bool isLocked() const {
+    return mLocked;
+  }
+
+  /**
+   * The lowest agreement score of the predictable bits. 0 if there is
+   * no candidate.
+   */
+  int8_t agreement() const;
+
+protected:
+  /**
+   * Callback function to be overridden by the derived class to obtain
+   * the predicted frame for the minute that begins at systick. It runs
+   * in the same context as the receiver's decoder.
+   */
+  TEXT_ISR_ATTR_4
+  virtual void onDCF77FrameReceived(const uint64_t dcf77frame,
+      const uint32_t systick) = 0;
+
+private:
+  static constexpr uint16_t UNKNOWN_AGE = 0xFFFF;
+
+  void advance(const uint32_t minutes);
+  void collectSections(const uint64_t bits);
+  bool assembleCandidate();
+  void predict();
+  void compare(const uint64_t bits);
+  void discardCandidate(const uint8_t bit);
+
+  /* Sections that passed their parity check, and their age in minutes. */
+  uint8_t mMinute = 0;
+  uint16_t mMinuteAge = UNKNOWN_AGE;
+  uint8_t mHour = 0;
+  uint16_t mHourAge = UNKNOWN_AGE;
+  uint16_t mDays = 0;
+  uint16_t mDateAge = UNKNOWN_AGE;
+  int8_t mIsdst = -1;
+
+  /* The local time of the minute, that began at the latest minute mark. */
+  bool mHasCandidate = false;
+  bool mCandidateIsdst = false;
+  uint32_t mCandidate = 0;
+  uint64_t mPredicted = 0;
+  /* Votes for A1 within the current hour. */
+  int8_t mA1Score = 0;
+  int8_t mScore[DCF77frame::BIT_COUNT];
+
+  uint8_t mLockThreshold;
+  bool mLocked = false;
+  bool mHasSystick = false;
+  uint32_t mSystick = 0;
+  /* The latest minute mark off the whole minutes after mSystick. */
+  bool mHasStrayMark = false;
+  uint32_t mStrayMark = 0;
+};
+
+#endif /* DCF77accumulator_H_ */
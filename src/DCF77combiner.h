@@ -0,0 +1,201 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77combiner_H_
+#define DCF77combiner_H_
+
+#include <stdint.h>
+#include "DCF77rxtm.h"
+#include "internal/ISR_ATTR.h"
+#include "internal/DCF77frame.h"
+
+/**
+ * The maximum number of receivers, that can be attached to a
+ * DCF77combiner. Each one takes DCF77frame::BIT_COUNT bytes for the
+ * votes of the current minute.
+ */
+#ifndef DCF77_COMBINER_RECEIVERS
+#define DCF77_COMBINER_RECEIVERS 3
+#endif
+
+/**
+ * DCF77combiner combines the bit decisions of several receivers, e.g.
+ * antennas mounted in different orientations. Every bit of the minute
+ * is voted on by all receivers before the parity is checked. A frame can
+ * be valid, even if none of the receivers got all bits right.
+ *
+ * Usage:
+ *
+ * class MyCombiner : public DCF77combiner {
+ *   // Same signature as DCF77rx::onDCF77FrameReceived().
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     ...
+ *   }
+ * };
+ *
+ * MyCombiner combiner;
+ * DCF77diversityRx<2> antennaA(combiner);
+ * DCF77diversityRx<3> antennaB(combiner);
+ * DCF77diversityRx<18> antennaC(combiner);
+ *
+ * void setup() {
+ *   antennaA.begin();
+ *   antennaB.begin();
+ *   antennaC.begin();
+ * }
+ *
+ * The votes of a receiver are held back until its minute mark, and
+ * are only counted if it received exactly 59 bits in that minute, or
+ * 60 in the minute of an announced leap second. A spike, that adds a
+ * bit, or a lost pulse would otherwise shift all its later votes to the
+ * wrong seconds. The votes are concluded, once every
+ * receiver has seen the minute mark, or at the latest one second later.
+ * The systick of the frame is that of the first receiver's minute mark.
+ *
+ * All receivers of a combiner must use the same DECODE_MODE. In mode
+ * DECODE_IN_POLL the receivers must be polled from the same task. In
+ * mode DECODE_IN_ISR the pin interrupts call vote() and onMinuteSync()
+ * and must not run concurrently. On ESP32 the pin interrupts run on the
+ * core that attached them, so call begin() of all receivers from the
+ * same core.
+ */
+class DCF77combiner {
+public:
+  /**
+   * MAJORITY: Every receiver has one vote per bit.
+   * CONFIDENCE_WEIGHTED: A vote is weighted with the distance of the
+   *  measured pulse width to the nominal one. See confidence().
+   */
+  enum VOTING : uint8_t {MAJORITY, CONFIDENCE_WEIGHTED};
+
+  explicit DCF77combiner(VOTING voting = CONFIDENCE_WEIGHTED)
+    : mVoting(voting) {
+    reset();
+  }
+
+  static constexpr uint8_t CONFIDENCE_RANGE_MILLIS = 60;
+  /**
+   * With CONFIDENCE_WEIGHTED a bit is only decided, if the weighted
+   * votes for 0 and 1 differ by at least this much. Votes, that nearly
+   * cancel, are no better than a guess.
+   */
+  static constexpr uint8_t MIN_WEIGHTED_MARGIN = 5;
+
+  /**
+   * The confidence of a bit decision, derived from the pulse width.
+   * It is maximal for the nominal width of 100ms (0) or 200ms (1) and
+   * decreases linearly to 0 within CONFIDENCE_RANGE_MILLIS.
+   */
+  static uint8_t confidence(const uint32_t pulseWidthMillis, const unsigned bit) {
+    const uint32_t nominal = bit ? 200 : 100;
+    const uint32_t deviation = pulseWidthMillis > nominal ?
+        pulseWidthMillis - nominal : nominal - pulseWidthMillis;
+    return deviation < CONFIDENCE_RANGE_MILLIS ? CONFIDENCE_RANGE_MILLIS - deviation : 0;
+  }
+
+  /* Returned by attach(), if DCF77_COMBINER_RECEIVERS are attached. */
+  static constexpr uint8_t NO_SLOT = 0xFF;
+
+  /**
+   * Called by DCF77rxbase::attachCombiner().
+   *
+   * @return The slot of the receiver or NO_SLOT.
+   */
+  uint8_t attach();
+
+  /**
+   * Called by a receiver for every bit received after a minute sync.
+   * The confidence is kept until the minute sync of the receiver.
+   *
+   * @param[in] slot The slot of the receiver.
+   * @param[in] second The second of minute the bit was received in.
+   * @param[in] confidence The confidence of the bit decision.
+   */
+  TEXT_ISR_ATTR_3
+  void vote(const uint8_t slot, const size_t second, const uint8_t confidence);
+
+  /**
+   * Called by a receiver when it detected the minute sync. Its bits of
+   * the past minute are counted, if they are a complete minute. See
+   * DCF77frame::completeMinute(). The votes are
+   * concluded, when all receivers have synced.
+   *
+   * @param[in] slot The slot of the receiver.
+   * @param[in] bits The bits of the past minute.
+   * @param[in] bitCount The number of bits received in the past minute,
+   *  0 if the receiver wasn't synced at its begin.
+   * @param[in] systick The time stamp of the minute mark.
+   */
+  TEXT_ISR_ATTR_3
+  void onMinuteSync(const uint8_t slot, const uint64_t bits, const size_t bitCount,
+      const uint32_t systick);
+
+protected:
+  /**
+   * Callback function to be overridden by the derived class to obtain
+   * a combined dcf77 frame. It runs in the same context as the
+   * receivers' decoders.
+   */
+  TEXT_ISR_ATTR_4
+  virtual void onDCF77FrameReceived(const uint64_t dcf77frame,
+      const uint32_t systick) = 0;
+
+private:
+  static_assert(DCF77_COMBINER_RECEIVERS <= 8, "At most 8 receivers per combiner");
+
+  void reset();
+  /* Decide on the votes of the past minute. */
+  void conclude();
+
+  /* Sum of the weighted votes per bit. Positive votes for 1. */
+  int16_t mScore[DCF77frame::BIT_COUNT];
+  /* The confidences of the current minute per receiver. */
+  uint8_t mConfidence[DCF77_COMBINER_RECEIVERS][DCF77frame::BIT_COUNT];
+  /* The receivers, that have synced since the votes were concluded. */
+  uint8_t mSynced;
+  /* The number of receivers, that voted on the past minute. */
+  uint8_t mVoters;
+  uint8_t mSlotCount = 0;
+  uint32_t mSystick;
+  VOTING mVoting;
+};
+
+/**
+ * A receiver that feeds a DCF77combiner. It doesn't deliver frames
+ * on its own.
+ */
+template<int RECEIVER_PIN> class DCF77diversityRx : public DCF77rx<RECEIVER_PIN> {
+public:
+  explicit DCF77diversityRx(DCF77combiner& combiner) {
+    this->attachCombiner(combiner);
+  }
+
+private:
+  void onDCF77FrameReceived(const uint64_t, const uint32_t) override {
+  }
+};
+
+#endif /* DCF77combiner_H_ */
@@ -0,0 +1,116 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#pragma once
+
+#ifndef DCF77frameSlot_H_
+#define DCF77frameSlot_H_
+
+#include <stdint.h>
+#include "internal/ISR_ATTR.h"
+#include "internal/DCF77seqlock.h"
+
+/**
+ * A received frame along with the time stamp of its minute mark.
+ */
+struct DCF77frameSnapshot {
+  uint64_t frame;
+  uint32_t systick;
+  /* The number of frames published so far. 0 before the first one. */
+  uint32_t sequence;
+};
+
+/**
+ * DCF77frameSlot passes the latest frame from onDCF77FrameReceived()
+ * to the main loop or to another task. The frame is 64 bits wide and
+ * comes with its systick, so a plain copy can be torn by the interrupt
+ * on any platform. Disabling the interrupts around the copy, however,
+ * doesn't protect against the other core of an ESP32.
+ *
+ * The slot is published through a sequence lock. The interrupt handler
+ * never waits, and a reader retries its copy in the rare case that a
+ * frame arrives meanwhile. The sequence number tells the readers, if
+ * the frame is new.
+ *
+ * class MyDcf77Receiver : public DCF77rx<DCF77_PIN> {
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     latestFrame.publish(dcf77frame, systick);
+ *   }
+ * public:
+ *   DCF77frameSlot latestFrame;
+ * };
+ *
+ * void loop() {
+ *   DCF77frameSnapshot snapshot;
+ *   if (myReceiver.latestFrame.read(snapshot) && snapshot.sequence != seen) {
+ *     seen = snapshot.sequence;
+ *     ...
+ *   }
+ * }
+ *
+ * There must be a single writer, and read() must not be called from
+ * an interrupt handler, that can interrupt publish(). See DCF77seqlock.
+ */
+class DCF77frameSlot {
+public:
+  /**
+   * Publish a frame. To be called by the writer only, e.g. from
+   * onDCF77FrameReceived() within the interrupt context.
+   *
+   * @param[in] dcf77frame The received frame.
+   * @param[in] systick The time stamp of the frame's minute mark.
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  void publish(const uint64_t dcf77frame, const uint32_t systick) {
+    DCF77frameSnapshot& slot = mLock.beginWrite();
+    slot.frame = dcf77frame;
+    slot.systick = systick;
+    slot.sequence = slot.sequence + 1;
+    mLock.endWrite();
+  }
+
+  /**
+   * Copy a consistent snapshot of the latest frame.
+   *
+   * @param[out] snapshot The frame, its systick and its sequence number.
+   * @return false, as long as no frame has been published.
+   */
+  bool read(DCF77frameSnapshot& snapshot) const {
+    mLock.read(snapshot);
+    return snapshot.sequence != 0;
+  }
+
+  /**
+   * The number of frames published so far.
+   */
+  uint32_t sequence() const {
+    DCF77frameSnapshot snapshot;
+    mLock.read(snapshot);
+    return snapshot.sequence;
+  }
+
+private:
+  DCF77seqlock<DCF77frameSnapshot> mLock;
+};
+
+#endif /* DCF77frameSlot_H_ */
@@ -0,0 +1,151 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#pragma once
+
+#ifndef DCF77powerScheduler_H_
+#define DCF77powerScheduler_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "DCF77wallclock.h"
+#include "internal/DCF77rxbase.h"
+#include "internal/DCF77powerSchedulerbase.h"
+
+/**
+ * The compile time parameters of DCF77powerScheduler.
+ *
+ * @tparam WARMUP_SECONDS The time from power on, until the receiver
+ *  output is valid. Depends on the receiver module and the antenna.
+ * @tparam WINDOW_MINUTES The time a window listens for a frame, before
+ *  it is given up.
+ * @tparam MAX_ERROR_MILLIS The error bound of the wall clock, that is
+ *  kept by the interval between the windows.
+ * @tparam MIN_INTERVAL_MINUTES The minimum time between two windows.
+ * @tparam MAX_INTERVAL_MINUTES The maximum time between two windows.
+ * @tparam ENABLE_LEVEL The level of the enable pin, that powers the
+ *  receiver.
+ */
+template<uint16_t WARMUP_SECONDS_ = 5, uint16_t WINDOW_MINUTES_ = 10,
+    uint16_t MAX_ERROR_MILLIS_ = 100, uint16_t MIN_INTERVAL_MINUTES_ = 15,
+    uint16_t MAX_INTERVAL_MINUTES_ = 720, uint8_t ENABLE_LEVEL_ = HIGH>
+struct DCF77powerPolicy {
+  static constexpr uint16_t WARMUP_SECONDS = WARMUP_SECONDS_;
+  static constexpr uint16_t WINDOW_MINUTES = WINDOW_MINUTES_;
+  static constexpr uint16_t MAX_ERROR_MILLIS = MAX_ERROR_MILLIS_;
+  static constexpr uint16_t MIN_INTERVAL_MINUTES = MIN_INTERVAL_MINUTES_;
+  static constexpr uint16_t MAX_INTERVAL_MINUTES = MAX_INTERVAL_MINUTES_;
+  static constexpr uint8_t ENABLE_LEVEL = ENABLE_LEVEL_;
+};
+
+/**
+ * DCF77powerScheduler runs the receiver in short sync windows for
+ * battery powered nodes. Between the windows the receiver is powered
+ * off through an enable pin and the pin interrupt is detached. The
+ * time is kept by DCF77wallclock in the meantime.
+ *
+ * A window powers the receiver on, waits WARMUP_SECONDS, attaches the
+ * receiver with begin() and listens until the clock has received a
+ * frame. Then the receiver is detached with end() and powered off.
+ * The first window stays open until the first frame, any further one
+ * is given up after WINDOW_MINUTES.
+ *
+ * The interval to the next window is the holdover time of the clock
+ * for MAX_ERROR_MILLIS, see DCF77wallclock::holdoverMillis(), less the
+ * warm-up and the time the latest window needed. It is short, as long
+ * as the drift of the system tick is unknown, and grows with the
+ * precision of the drift estimate. After a failed window, the interval
+ * starts at MIN_INTERVAL_MINUTES and doubles with every further one.
+ *
+ * class MyDcf77Receiver : public DCF77rx<DCF77_PIN> {
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     wallclock.update(dcf77frame, systick);
+ *   }
+ * public:
+ *   DCF77wallclock wallclock;
+ * };
+ *
+ * MyDcf77Receiver myReceiver;
+ * DCF77powerScheduler<MyDcf77Receiver, ENABLE_PIN> power(myReceiver, myReceiver.wallclock);
+ *
+ * void setup() {
+ *   power.begin();
+ * }
+ *
+ * void loop() {
+ *   power.poll();
+ *   ...
+ * }
+ *
+ * Don't call begin() of the receiver directly. Between the windows,
+ * the MCU can sleep until the next one, see intervalMillis().
+ *
+ * @tparam RECEIVER The receiver class with begin(DECODE_MODE) and
+ *  end(), e.g. derived from DCF77rx or DCF77rxStatic.
+ * @tparam ENABLE_PIN The pin, that powers the receiver.
+ * @tparam POLICY See DCF77powerPolicy.
+ */
+template<typename RECEIVER, int ENABLE_PIN, typename POLICY = DCF77powerPolicy<>>
+class DCF77powerScheduler : public DCF77powerSchedulerbase {
+public:
+  DCF77powerScheduler(RECEIVER& receiver, DCF77wallclock& clock)
+    : DCF77powerSchedulerbase(clock, POLICY::WARMUP_SECONDS * 1000UL,
+        POLICY::WINDOW_MINUTES * 60000UL, POLICY::MAX_ERROR_MILLIS,
+        POLICY::MIN_INTERVAL_MINUTES * 60000UL, POLICY::MAX_INTERVAL_MINUTES * 60000UL),
+      mReceiver(receiver) {
+  }
+
+  /**
+   * Configure the enable pin and open the first window. To be called
+   * once during setup().
+   *
+   * @param[in] mode The decode mode passed to begin() of the receiver.
+   */
+  void begin(const DCF77rxbase::DECODE_MODE mode = DCF77rxbase::DECODE_IN_ISR) {
+    mDecodeMode = mode;
+    pinMode(ENABLE_PIN, OUTPUT);
+    start();
+  }
+
+private:
+  static_assert(POLICY::MIN_INTERVAL_MINUTES <= POLICY::MAX_INTERVAL_MINUTES,
+      "MIN_INTERVAL_MINUTES must not exceed MAX_INTERVAL_MINUTES");
+
+  void enableReceiver(const bool on) override {
+    const uint8_t off = POLICY::ENABLE_LEVEL == HIGH ? LOW : HIGH;
+    digitalWrite(ENABLE_PIN, on ? POLICY::ENABLE_LEVEL : off);
+  }
+
+  void attachReceiver(const bool on) override {
+    if (on) {
+      mReceiver.begin(mDecodeMode);
+    } else {
+      mReceiver.end();
+    }
+  }
+
+  RECEIVER& mReceiver;
+  DCF77rxbase::DECODE_MODE mDecodeMode = DCF77rxbase::DECODE_IN_ISR;
+};
+
+#endif /* DCF77powerScheduler_H_ */
@@ -0,0 +1,586 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77rxStatic_H_
+#define DCF77rxStatic_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "DCF77tm.h"
+#include "DCF77trace.h"
+#include "internal/ISR_ATTR.h"
+#include "internal/DCF77rxbase.h"
+#include "internal/DCF77queue.h"
+#include "internal/DCF77pin.h"
+#include "internal/DCF77timesource.h"
+
+/**
+ * The compile time parameters of DCF77rxStatic.
+ *
+ * @tparam TIMESOURCE The time stamps of the edges. See DCF77timesource.h.
+ * @tparam SPLIT_MILLIS A pulse of at least this width is a "1", a
+ *  shorter one a "0".
+ * @tparam SYNC_MILLIS A gap of more than this between two pulses is the
+ *  missing pulse of second 59, the next pulse starts a minute.
+ * @tparam PULSE_QUEUE_SIZE Number of pulses the interrupt handler can
+ *  buffer in mode DECODE_IN_POLL, until poll() must be called. Two
+ *  pulses are received per second. Must be a power of 2.
+ * @tparam GLITCH_MILLIS Glitch filter. Two edges less than this apart
+ *  are a spike and are both dropped. 0 disables the filter.
+ * @tparam STORM_EDGES Interrupt storm protection. If more edges than
+ *  this arrive within a second, the pin interrupt is detached until
+ *  the second has passed. Only poll() re-arms it, so poll() must be
+ *  called frequently also in mode DECODE_IN_ISR. 0 disables the
+ *  protection.
+ * @tparam PPS_PIN Output pin for a pulse of 100ms at the begin of every
+ *  second. -1 disables the output.
+ */
+template<typename TIMESOURCE_ = DCF77millis, uint16_t SPLIT_MILLIS_ = 170,
+    uint16_t SYNC_MILLIS_ = 1200, uint8_t PULSE_QUEUE_SIZE_ = DCF77_PULSE_QUEUE_SIZE,
+    uint16_t GLITCH_MILLIS_ = 0, uint16_t STORM_EDGES_ = 0, int PPS_PIN_ = -1>
+struct DCF77rxPolicy {
+  typedef TIMESOURCE_ TIMESOURCE;
+  static constexpr uint16_t SPLIT_MILLIS = SPLIT_MILLIS_;
+  static constexpr uint16_t SYNC_MILLIS = SYNC_MILLIS_;
+  static constexpr uint8_t PULSE_QUEUE_SIZE = PULSE_QUEUE_SIZE_;
+  static constexpr uint16_t GLITCH_MILLIS = GLITCH_MILLIS_;
+  static constexpr uint16_t STORM_EDGES = STORM_EDGES_;
+  static constexpr int PPS_PIN = PPS_PIN_;
+};
+
+/**
+ * DCF77rxStatic receives dcf77 pulses on a digital pin like DCF77rx,
+ * but without virtual functions. The derived class is passed as
+ * template parameter DERIVED and its onDCF77FrameReceived() is called
+ * directly. The thresholds and the queue size are compile time
+ * constants of POLICY. This lets the compiler inline the whole chain
+ * from the pin interrupt to the callback. On ESP32 there is no vtable
+ * that must be placed in RAM.
+ *
+ * static constexpr int DCF77_PIN = 3;
+ *
+ * class MyDcf77Receiver : public DCF77rxStatic<MyDcf77Receiver, DCF77_PIN> {
+ * public:
+ *   // Called from the pin interrupt or from poll(), like the callback
+ *   // of DCF77rx. It must be accessible by DCF77rxStatic.
+ *   TEXT_ISR_ATTR_1_INLINE
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) {
+ *     ...
+ *   }
+ * };
+ *
+ * A policy with micros() time stamps and a larger queue:
+ *
+ * class MyDcf77Receiver : public DCF77rxStatic<MyDcf77Receiver, DCF77_PIN,
+ *     DCF77rxPolicy<DCF77micros, 170, 1200, 32>> {
+ *   ...
+ * };
+ *
+ * A noisy receiver output can be cleaned up by the glitch filter, and
+ * the CPU load of a burst of edges can be bounded by the storm
+ * protection. Both are set by the policy, e.g. to drop spikes shorter
+ * than 10ms and to allow 20 edges per second:
+ *
+ *   DCF77rxPolicy<DCF77millis, 170, 1200, DCF77_PULSE_QUEUE_SIZE, 10, 20>
+ *
+ * The glitch filter holds back every edge until the next one has
+ * arrived, so the frame of a minute is delivered with the end of the
+ * first pulse of the next minute. The system tick still refers to the
+ * minute mark. With storm protection, poll() must be called frequently
+ * also in mode DECODE_IN_ISR, since it re-arms the pin interrupt.
+ *
+ * The derived class can also be called at the begin of every second:
+ *
+ *   void onDCF77Second(const uint8_t second, const uint32_t systick,
+ *       const bool extrapolated) {
+ *     ...
+ *   }
+ *
+ * second is the second of minute, or UNKNOWN_SECOND until the first
+ * minute mark. systick is the time stamp of the second mark, the
+ * falling edge at the begin of the pulse. A second without mark, like
+ * second 59 or a second lost in the noise, is extrapolated by poll()
+ * exactly one second after the previous one and reported with
+ * extrapolated set. A mark, that arrives after its second has been
+ * extrapolated, realigns the following seconds. The policy can also
+ * drive a 1PPS output pin along with the callback.
+ *
+ * The callback and the 1PPS output follow the second mark with the
+ * interrupt latency in mode DECODE_IN_ISR without glitch filter.
+ * Otherwise they are delayed until poll() or the next edge, but systick
+ * is still exact. Only poll() extrapolates seconds and ends the 1PPS
+ * pulse, also in mode DECODE_IN_ISR: if onDCF77Second() is implemented
+ * or PPS_PIN is set, poll() must be called every few milliseconds.
+ * Without it second 59 is never reported, and the 1PPS output stays
+ * high.
+ *
+ * Only one receiver can be instantiated per pin.
+ */
+template<typename DERIVED, int RECEIVER_PIN, typename POLICY = DCF77rxPolicy<>>
+class DCF77rxStatic : public DCF77rxbase {
+public:
+  typedef typename POLICY::TIMESOURCE TIMESOURCE;
+
+  DCF77rxStatic() : DCF77rxbase(TIMESOURCE::TICKS_PER_MILLI) {
+    // Make this object responsible for receiving
+    // Dcf77 signals from the pin RECEIVER_PIN.
+    mInstance = this;
+  }
+
+  /**
+   * Start receiving dcf77 frames. To be called once during
+   * setup().
+   *
+   * @param[in] mode DECODE_IN_ISR or DECODE_IN_POLL. See
+   *  DCF77rxbase::DECODE_MODE.
+   */
+  void begin(DECODE_MODE mode = DECODE_IN_ISR) {
+    mDecodeMode = mode;
+    if (POLICY::PPS_PIN >= 0) {
+      pinMode(POLICY::PPS_PIN, OUTPUT);
+      DCF77pin<POLICY::PPS_PIN>::write(LOW);
+    }
+    pinMode(RECEIVER_PIN, INPUT_PULLUP);
+    arm(TIMESOURCE::now());
+  }
+
+  /**
+   * Stop receiving, e.g. before the receiver is powered off. Detaches
+   * the pin interrupt and drops the bits of the incomplete minute and
+   * the pulses not yet decoded. The pull-up is switched off, so that
+   * no current flows into an unpowered receiver. The second of minute
+   * is unknown after the next begin().
+   */
+  void end() {
+    detachInterrupt(digitalPinToInterrupt(RECEIVER_PIN));
+    pinMode(RECEIVER_PIN, INPUT);
+    DCF77pulse dropped;
+    while (mPulseQueue.pop(dropped)) {
+    }
+    mPulseOverflowsSeen = mPulseQueue.overflowCount();
+    mGlitchPending = false;
+    mDetached = false;
+    discardReceivedBits();
+    mSecondValid = false;
+    mSecondOfMinute = UNKNOWN_SECOND;
+    if (mPpsHigh) {
+      mPpsHigh = false;
+      DCF77pin<POLICY::PPS_PIN>::write(LOW);
+    }
+  }
+
+  /**
+   * To be called by the interrupt handler.
+   *
+   * @param[in] pinLevel The level of the receiver pin, read by the
+   *  interrupt handler after the edge. See DCF77pin.
+   * @param[in] time The time stamp of the edge in ticks of TIMESOURCE.
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  void onPinInterrupt(const int pinLevel, const uint32_t time) {
+    if (mTrace != nullptr) {
+      mTrace->record(pinLevel, time);
+    }
+
+    if (POLICY::STORM_EDGES != 0) {
+      if (time - mStormWindowStart >= SECOND_TICKS) {
+        mStormWindowStart = time;
+        mStormWindowEdges = 0;
+      }
+      if (++mStormWindowEdges > POLICY::STORM_EDGES) {
+        detachInterrupt(digitalPinToInterrupt(RECEIVER_PIN));
+        mDetached = true;
+        mStormCount.increment();
+        return;
+      }
+    }
+
+    DCF77pulse dcf77signal;
+    dcf77signal.mPulseLevel = pinLevel;
+    dcf77signal.mPulseTime = time;
+
+    if (POLICY::GLITCH_MILLIS != 0) {
+      // Hold back the edge, until the next one proves it isn't the
+      // begin of a spike.
+      if (mGlitchPending) {
+        if (time - mGlitchEdge.mPulseTime < GLITCH_TICKS) {
+          mGlitchPending = false;
+          mGlitchCount.increment();
+          return;
+        }
+        dispatchPulse(mGlitchEdge);
+      }
+      mGlitchEdge = dcf77signal;
+      mGlitchPending = true;
+      return;
+    }
+    dispatchPulse(dcf77signal);
+  }
+
+  /**
+   * Record the edges into trace, before they pass the glitch filter.
+   * A trace can be replayed on the host by passing its edges to
+   * onPinInterrupt() of a receiver with the same policy. See DCF77trace.
+   */
+  void attachTrace(DCF77trace& trace) {
+    trace.mTicksPerMilli = TIMESOURCE::TICKS_PER_MILLI;
+    mTrace = &trace;
+  }
+
+  /**
+   * Decode the pulses that the interrupt handler has queued in mode
+   * DECODE_IN_POLL. To be called frequently from loop() or a task,
+   * at least once within PULSE_QUEUE_SIZE / 2 seconds. Extrapolates
+   * the seconds without second mark and re-arms the pin interrupt
+   * after a storm in all modes.
+   *
+   * @return The number of decoded pulses.
+   */
+  size_t poll() {
+    if (POLICY::STORM_EDGES != 0 && mDetached) {
+      const uint32_t now = TIMESOURCE::now();
+      if (now - mStormWindowStart >= SECOND_TICKS) {
+        // The edges of the storm corrupted the current minute.
+        DCF77pulse dropped;
+        while (mPulseQueue.pop(dropped)) {
+        }
+        discardReceivedBits();
+        arm(now);
+      }
+    }
+
+    // A lost pulse corrupts the frame that is currently received.
+    const uint32_t pulseOverflows = mPulseQueue.overflowCount();
+    if (pulseOverflows != mPulseOverflowsSeen) {
+      mPulseOverflowsSeen = pulseOverflows;
+      discardReceivedBits();
+    }
+
+    size_t count = 0;
+    DCF77pulse dcf77signal;
+    while (mPulseQueue.pop(dcf77signal)) {
+      processPulse(dcf77signal);
+      count++;
+    }
+    extrapolateSeconds();
+    return count;
+  }
+
+  /**
+   * The number of pulses that were lost in mode DECODE_IN_POLL,
+   * because poll() wasn't called in time. A frame that has lost a
+   * pulse is discarded.
+   */
+  uint32_t pulseOverflowCount() const {
+    return mPulseQueue.overflowCount();
+  }
+
+  /**
+   * The number of spikes that were dropped by the glitch filter.
+   */
+  uint32_t glitchCount() const {
+    return mGlitchCount.value();
+  }
+
+  /**
+   * The number of times the pin interrupt was detached, because the
+   * edge rate exceeded the limit.
+   */
+  uint32_t stormCount() const {
+    return mStormCount.value();
+  }
+
+  /**
+   * The pin interrupt is detached due to an interrupt storm.
+   */
+  bool isDetached() const {
+    return mDetached;
+  }
+
+  /**
+   * The second passed to onDCF77Second() until the first minute mark.
+   */
+  static constexpr uint8_t UNKNOWN_SECOND = 0xFF;
+
+#if DCF77_INSTRUMENTATION
+  /**
+   * A snapshot of the instrumentation. The decoder and the interrupt
+   * handler events are each consistent in themselves. Must not be
+   * called from interrupt context. See DCF77_INSTRUMENTATION.
+   *
+   * @param[out] stats The counters and the histogram.
+   */
+  void statistics(DCF77rxStats& stats) const {
+    decoderStats(stats.decoder);
+    mIsrStats.read(stats.isr);
+  }
+#endif
+
+protected:
+  /**
+   * Does nothing. A derived class, that wants to be called every
+   * second, hides it by its own onDCF77Second().
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  void onDCF77Second(const uint8_t, const uint32_t, const bool) {
+  }
+
+private:
+  /* The thresholds in ticks of the time source. */
+  static constexpr uint32_t SPLIT_TICKS =
+      static_cast<uint32_t>(POLICY::SPLIT_MILLIS) * TIMESOURCE::TICKS_PER_MILLI;
+  static constexpr uint32_t SYNC_TICKS =
+      static_cast<uint32_t>(POLICY::SYNC_MILLIS) * TIMESOURCE::TICKS_PER_MILLI;
+  static constexpr uint32_t GLITCH_TICKS =
+      static_cast<uint32_t>(POLICY::GLITCH_MILLIS) * TIMESOURCE::TICKS_PER_MILLI;
+  static constexpr uint32_t SECOND_TICKS = 1000UL * TIMESOURCE::TICKS_PER_MILLI;
+  /* A second mark this close to an extrapolated second belongs to it.
+     A mark this close to the next second is noise. */
+  static constexpr uint32_t SECOND_WINDOW_TICKS = 200UL * TIMESOURCE::TICKS_PER_MILLI;
+  static constexpr uint32_t PPS_TICKS = 100UL * TIMESOURCE::TICKS_PER_MILLI;
+  static_assert(SPLIT_TICKS < SYNC_TICKS, "SPLIT_MILLIS must be below SYNC_MILLIS");
+  static_assert(POLICY::GLITCH_MILLIS < 100, "GLITCH_MILLIS must be below the pulse width");
+
+  /* mPulseTime is in ticks of the time source. */
+  struct DCF77pulse {uint32_t mPulseTime = 0; int mPulseLevel = HIGH;};
+
+  /**
+   * The interrupt handler that is called upon a level change on
+   * the RECEIVER_PIN.
+   */
+  TEXT_ISR_ATTR_0
+  static void intHandler() {
+#if DCF77_INSTRUMENTATION
+    const uint32_t start = DCF77_ISR_CLOCK();
+#endif
+    const uint32_t time = TIMESOURCE::now();
+    // Read the level after the time stamp. It takes some time to
+    // activate the interrupt routine, so the signal has settled.
+    mInstance->onPinInterrupt(DCF77pin<RECEIVER_PIN>::read(), time);
+#if DCF77_INSTRUMENTATION
+    mInstance->countIsr(DCF77_ISR_CLOCK() - start);
+#endif
+  }
+
+#if DCF77_INSTRUMENTATION
+  TEXT_ISR_ATTR_1_INLINE
+  void countIsr(uint32_t ticks) {
+    uint8_t bin = 0;
+    while (ticks != 0 && bin < DCF77_ISR_HISTOGRAM_BINS - 1) {
+      ticks >>= 1;
+      bin++;
+    }
+    DCF77isrStats& stats = mIsrStats.beginWrite();
+    stats.edges++;
+    stats.isrTicks[bin]++;
+    mIsrStats.endWrite();
+  }
+#endif
+
+  /**
+   * Attach the pin interrupt and restart the edge detection.
+   *
+   * @param[in] now The current time stamp.
+   */
+  void arm(const uint32_t now) {
+    mPreviousPulse.mPulseLevel = digitalRead(RECEIVER_PIN);
+    // A gap since the previous edge must not be taken for a minute mark.
+    mPreviousPulse.mPulseTime = now;
+    mGlitchPending = false;
+    mStormWindowStart = now;
+    mStormWindowEdges = 0;
+    mDetached = false;
+    attachInterrupt(digitalPinToInterrupt(RECEIVER_PIN), intHandler, CHANGE);
+  }
+
+  TEXT_ISR_ATTR_2_INLINE
+  void dispatchPulse(const DCF77pulse &dcf77signal) {
+    if (mDecodeMode == DECODE_IN_POLL) {
+      mPulseQueue.push(dcf77signal);
+    } else {
+      processPulse(dcf77signal);
+    }
+  }
+
+  TEXT_ISR_ATTR_2_INLINE
+  void processPulse(const DCF77pulse &dcf77signal) {
+    if (dcf77signal.mPulseLevel == LOW) {
+      if (mPreviousPulse.mPulseLevel != LOW) {
+        /* falling edge */
+        // Unsigned difference, correct across the wraparound of the ticks.
+        const bool minuteMark = (dcf77signal.mPulseTime - mPreviousPulse.mPulseTime) > SYNC_TICKS;
+        bool frameReceived = false;
+        if (minuteMark) {
+          uint64_t dcf77frame;
+          if (processMinuteSync(dcf77signal.mPulseTime, dcf77frame)) {
+            frameReceived = true;
+            static_cast<DERIVED*>(this)->onDCF77FrameReceived(dcf77frame, dcf77signal.mPulseTime);
+          }
+        }
+        processSecondMark(dcf77signal.mPulseTime);
+        onSecondMark(dcf77signal.mPulseTime, minuteMark, frameReceived);
+        mPreviousPulse = dcf77signal;
+      }
+    } else {
+      if (mPreviousPulse.mPulseLevel == LOW) {
+        /* rising edge */
+        const uint32_t difference = dcf77signal.mPulseTime - mPreviousPulse.mPulseTime;
+        const unsigned bit = difference < SPLIT_TICKS ? 0 : 1;
+        processBit(bit, pulseConfidence(difference, bit));
+        mPreviousPulse.mPulseLevel = dcf77signal.mPulseLevel;
+      }
+    }
+  }
+
+  /**
+   * Report the second that begins with a second mark, unless the mark
+   * is noise or the second has already been extrapolated.
+   *
+   * @param[in] time The time stamp of the second mark.
+   * @param[in] minuteMark The mark follows a gap. This is the minute
+   *  mark or the mark after a missing one.
+   * @param[in] frameReceived The minute mark concluded a valid frame.
+   */
+  TEXT_ISR_ATTR_2_INLINE
+  void onSecondMark(const uint32_t time, const bool minuteMark, const bool frameReceived) {
+    const uint32_t sinceSecond = time - mSecondTick;
+    // A gap is taken for the minute mark, while the second of minute
+    // is unknown. A valid frame corrects a wrong guess.
+    const bool secondZero = frameReceived
+        || (minuteMark && mSecondOfMinute == UNKNOWN_SECOND);
+    if (mSecondValid) {
+      if (mSecondExtrapolated && sinceSecond < SECOND_WINDOW_TICKS) {
+        // The mark of an extrapolated second was late. Lock to it.
+        mSecondTick = time;
+        mSecondExtrapolated = false;
+        if (secondZero) {
+          mSecondOfMinute = 0;
+        }
+        return;
+      }
+      if (sinceSecond < SECOND_TICKS - SECOND_WINDOW_TICKS) {
+        return;
+      }
+    }
+
+    uint8_t second = UNKNOWN_SECOND;
+    if (secondZero) {
+      second = 0;
+    } else if (mSecondValid && mSecondOfMinute != UNKNOWN_SECOND) {
+      // Count the seconds, that passed unnoticed, e.g. while poll()
+      // wasn't called.
+      const uint32_t seconds = (sinceSecond + SECOND_TICKS / 2) / SECOND_TICKS;
+      second = static_cast<uint8_t>((mSecondOfMinute + seconds) % 60);
+    }
+    mSecondTick = time;
+    mSecondOfMinute = second;
+    mSecondValid = true;
+    mSecondExtrapolated = false;
+    beginPps(time);
+    static_cast<DERIVED*>(this)->onDCF77Second(second, time, false);
+  }
+
+  /**
+   * Report the seconds, whose mark is overdue, and end the 1PPS pulse.
+   */
+  void extrapolateSeconds() {
+    for (;;) {
+      noInterrupts();
+      const uint32_t now = TIMESOURCE::now();
+      if (POLICY::PPS_PIN >= 0 && mPpsHigh && now - mPpsStart >= PPS_TICKS) {
+        mPpsHigh = false;
+        DCF77pin<POLICY::PPS_PIN>::write(LOW);
+      }
+      // A late mark realigns the extrapolated second in onSecondMark().
+      const bool due = mSecondValid && now - mSecondTick >= SECOND_TICKS;
+      uint8_t second = UNKNOWN_SECOND;
+      if (due) {
+        if (mSecondOfMinute != UNKNOWN_SECOND) {
+          second = mSecondOfMinute == 59 ? 0 : mSecondOfMinute + 1;
+        }
+        mSecondTick = mSecondTick + SECOND_TICKS;
+        mSecondOfMinute = second;
+        mSecondExtrapolated = true;
+        beginPps(mSecondTick);
+      }
+      const uint32_t tick = mSecondTick;
+      interrupts();
+      if (not due) {
+        return;
+      }
+      static_cast<DERIVED*>(this)->onDCF77Second(second, tick, true);
+    }
+  }
+
+  /**
+   * Raise the 1PPS output, if the policy has one.
+   *
+   * @param[in] tick The begin of the second.
+   */
+  TEXT_ISR_ATTR_2_INLINE
+  void beginPps(const uint32_t tick) {
+    if (POLICY::PPS_PIN >= 0) {
+      DCF77pin<POLICY::PPS_PIN>::write(HIGH);
+      mPpsStart = tick;
+      mPpsHigh = true;
+    }
+  }
+
+  /* The instance that is responsible for pin RECEIVE_PIN. */
+  static DCF77rxStatic* mInstance;
+
+  DCF77pulse mPreviousPulse;
+  DECODE_MODE mDecodeMode = DECODE_IN_ISR;
+  uint32_t mPulseOverflowsSeen = 0;
+  /* Glitch filter: The edge held back. */
+  DCF77pulse mGlitchEdge;
+  bool mGlitchPending = false;
+  DCF77isrCounter mGlitchCount;
+  /* Storm protection: The edges since the begin of the window. */
+  uint32_t mStormWindowStart = 0;
+  uint16_t mStormWindowEdges = 0;
+  volatile bool mDetached = false;
+  DCF77isrCounter mStormCount;
+  DCF77trace* mTrace = nullptr;
+  /* The begin of the latest second, received or extrapolated. */
+  volatile uint32_t mSecondTick = 0;
+  volatile uint8_t mSecondOfMinute = UNKNOWN_SECOND;
+  volatile bool mSecondValid = false;
+  volatile bool mSecondExtrapolated = false;
+  /* The 1PPS output is high since mPpsStart. */
+  volatile uint32_t mPpsStart = 0;
+  volatile bool mPpsHigh = false;
+#if DCF77_INSTRUMENTATION
+  DCF77seqlock<DCF77isrStats> mIsrStats;
+#endif
+  DCF77spscQueue<DCF77pulse, POLICY::PULSE_QUEUE_SIZE> mPulseQueue;
+};
+
+template<typename DERIVED, int RECEIVER_PIN, typename POLICY>
+DCF77rxStatic<DERIVED, RECEIVER_PIN, POLICY>
+    *DCF77rxStatic<DERIVED, RECEIVER_PIN, POLICY>::mInstance = nullptr;
+
+#endif /* DCF77rxStatic_H_ */
@@ -31,7 +31,8 @@
 #include <Arduino.h>
 #include "DCF77tm.h"
 #include "internal/ISR_ATTR.h"
-#include "internal/DCF77rxbase.h"
+#include "internal/DCF77timesource.h"
+#include "DCF77rxStatic.h"
 
 /**
  * DCF77rx is the main API class. It receives dcf77 pulses on a digital pin.
@@ -66,39 +67,67 @@
  *   ...
  * }
  *
+ * By default, onDCF77FrameReceived() is called within the interrupt
+ * context. Alternatively, the interrupt handler can just queue the
+ * pulses and leave the decoding to the main loop:
+ *
+ * void setup() {
+ *   ...
+ *   myReceiver.begin(MyDcf77Receiver::DECODE_IN_POLL);
+ *   ...
+ * }
+ *
+ * void loop() {
+ *   // Calls onDCF77FrameReceived(), when a frame is complete.
+ *   myReceiver.poll();
+ *   ...
+ * }
+ *
+ * The edges are time stamped with millis() by default. For sub
+ * millisecond accuracy of the pulse widths and of the systick passed to
+ * onDCF77FrameReceived(), select micros() or a hardware input capture
+ * with parameter TIMESOURCE. See DCF77timesource.h. The systick is
+ * then in ticks of the time source:
+ *
+ * class MyDcf77Receiver : public DCF77rx<DCF77_PIN, DCF77micros> {
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     // DCF77wallclock counts in milliseconds.
+ *     myClock.update(dcf77frame, DCF77micros::toMillis(systick));
+ *   }
+ * };
+ *
+ * DCF77rx is a thin adapter of DCF77rxStatic, which calls the virtual
+ * onDCF77FrameReceived(). Derive from DCF77rxStatic directly to avoid
+ * the virtual call and to adjust the pulse thresholds.
+ *
  */
-template<int RECEIVER_PIN> class DCF77rx : public DCF77rxbase {
-public:
-  DCF77rx() {
-	  // Make this object responsible for receiving
-	  // Dcf77 signals from the pin RECEIVER_PIN.
-		mInstance = this;
-	}
+template<int RECEIVER_PIN, typename TIMESOURCE = DCF77millis> class DCF77rx
+    : public DCF77rxStatic<DCF77rx<RECEIVER_PIN, TIMESOURCE>, RECEIVER_PIN,
+        DCF77rxPolicy<TIMESOURCE>> {
+	friend class DCF77rxStatic<DCF77rx<RECEIVER_PIN, TIMESOURCE>, RECEIVER_PIN,
+	    DCF77rxPolicy<TIMESOURCE>>;
 
+private:
 	/**
-	 * Start receiving dcf77 frames. To be called once during
-	 * setup().
+	 * Callback function to be overridden by the derived class to
+	 * obtain a received dcf77 frame. Note that in mode DECODE_IN_ISR
+	 * this function runs within the interrupt context and must be
+	 * executed quickly in order not to prevent other lower priority
+	 * interrupts to be serviced. In mode DECODE_IN_POLL it is called
+	 * from poll().
 	 */
-	void begin() {
-		DCF77rxbase::begin(RECEIVER_PIN, intHandler);
-	}
-
-private:
-	/* The instance that is responsible for pin RECEIVE_PIN. */
-	static DCF77rxbase* mInstance;
+	TEXT_ISR_ATTR_4
+	virtual void onDCF77FrameReceived(const uint64_t dcf77frame,
+	    const uint32_t systick) = 0;
 
 	/**
-	 * The interrupt handler that is called upon a level change on
-	 * the RECEIVER_PIN.
+	 * Callback function, that may be overridden to be called at the
+	 * begin of every second. poll() must be called frequently, also in
+	 * mode DECODE_IN_ISR. See DCF77rxStatic.
 	 */
-	TEXT_ISR_ATTR_0
-	static void intHandler() {
-		mInstance->onPinInterrupt(RECEIVER_PIN);
+	TEXT_ISR_ATTR_4
+	virtual void onDCF77Second(const uint8_t, const uint32_t, const bool) {
 	}
 };
 
-template<int RECEIVER_PIN>
-
-DCF77rxbase *DCF77rx<RECEIVER_PIN>::mInstance = nullptr;
-
 #endif /* DCF77rxtm_H_ */
@@ -0,0 +1,100 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77sampledRx_H_
+#define DCF77sampledRx_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "DCF77tm.h"
+#include "internal/ISR_ATTR.h"
+#include "internal/DCF77sampledRxbase.h"
+#include "internal/DCF77pin.h"
+
+/**
+ * DCF77sampledRx is an alternative to DCF77rx for noisy signals and for
+ * pins without pin interrupt. Instead of measuring the time between
+ * edges, it samples the pin every DCF77_SAMPLE_MILLIS milliseconds and
+ * decodes each second with a matched filter. See DCF77matchedFilter.
+ *
+ * The library can't set up a timer portably. The application calls
+ * sample() from a timer interrupt, e.g. with the TimerOne library:
+ *
+ * static constexpr int DCF77_PIN = 7;
+ *
+ * class MyDcf77Receiver : public DCF77sampledRx<DCF77_PIN> {
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     ...
+ *   }
+ * };
+ *
+ * MyDcf77Receiver myReceiver;
+ *
+ * void setup() {
+ *   myReceiver.begin();
+ *   Timer1.initialize(DCF77_SAMPLE_MILLIS * 1000);
+ *   Timer1.attachInterrupt(MyDcf77Receiver::sample);
+ * }
+ *
+ * DECODE_IN_POLL and attachCombiner() work as for DCF77rx. The bits are
+ * forwarded to a combiner with the confidence of the matched filter.
+ */
+template<int RECEIVER_PIN> class DCF77sampledRx : public DCF77sampledRxbase {
+public:
+  DCF77sampledRx() {
+    // Make this object responsible for sampling the pin RECEIVER_PIN.
+    mInstance = this;
+  }
+
+  /**
+   * Start receiving dcf77 frames. To be called once during
+   * setup().
+   *
+   * @param[in] mode DECODE_IN_ISR or DECODE_IN_POLL. See
+   *  DCF77rxbase::DECODE_MODE.
+   */
+  void begin(DECODE_MODE mode = DECODE_IN_ISR) {
+    DCF77sampledRxbase::begin(RECEIVER_PIN, mode);
+  }
+
+  /**
+   * The sample handler to be called by a timer interrupt every
+   * DCF77_SAMPLE_MILLIS milliseconds.
+   */
+  TEXT_ISR_ATTR_0
+  static void sample() {
+    mInstance->onSampleTick(DCF77pin<RECEIVER_PIN>::read());
+  }
+
+private:
+  /* The instance that is responsible for pin RECEIVE_PIN. */
+  static DCF77sampledRxbase* mInstance;
+};
+
+template<int RECEIVER_PIN>
+DCF77sampledRxbase *DCF77sampledRx<RECEIVER_PIN>::mInstance = nullptr;
+
+#endif /* DCF77sampledRx_H_ */
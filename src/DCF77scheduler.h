@@ -0,0 +1,84 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77scheduler_H_
+#define DCF77scheduler_H_
+
+#include <stdint.h>
+#include "DCF77tm.h"
+#include "DCF77wallclock.h"
+#include "internal/DCF77schedulerbase.h"
+
+/**
+ * DCF77scheduler fires events at absolute or recurring local times,
+ * e.g. to switch a relay at 06:00 every day. The events are kept in a
+ * min-heap ordered by their due time, so a call of run() or poll(),
+ * that finds no event due, only compares one time stamp.
+ *
+ * The due times are local time stamps like those of
+ * DCF77wallclock::getTimestamp(). Hence a daily event stays at its
+ * local time of day across the changes between CET and CEST:
+ *
+ * - An event within the hour, that is skipped in spring, fires at
+ *   03:00 CEST.
+ * - An event within the hour, that is repeated in autumn, fires only
+ *   in the first pass. The same holds for a backward correction of the
+ *   time by a new frame: an event never fires twice for the same due
+ *   time.
+ *
+ * A recurring period counts seconds of local time, too. An hourly
+ * event has a gap of two hours in real time at the change to CET.
+ *
+ * class MyScheduler : public DCF77scheduler<8> {
+ *   void onScheduledEvent(const EVENT_ID id, const DCF77::time_t due) override {
+ *     digitalWrite(RELAY_PIN, id == relayOn ? HIGH : LOW);
+ *   }
+ * public:
+ *   EVENT_ID relayOn = daily(6, 0);
+ *   EVENT_ID relayOff = daily(22, 30);
+ * };
+ *
+ * MyScheduler scheduler;
+ *
+ * void loop() {
+ *   scheduler.poll(myReceiver.wallclock);
+ * }
+ *
+ * @tparam CAPACITY The maximum number of scheduled events.
+ */
+template<uint16_t CAPACITY> class DCF77scheduler : public DCF77schedulerbase {
+  static_assert(CAPACITY > 0 && CAPACITY < NO_EVENT, "CAPACITY is out of range");
+
+public:
+  DCF77scheduler() : DCF77schedulerbase(mEventStorage, mHeapStorage, CAPACITY) {
+  }
+
+private:
+  Event mEventStorage[CAPACITY];
+  uint16_t mHeapStorage[CAPACITY];
+};
+
+#endif /* DCF77scheduler_H_ */
@@ -29,6 +29,7 @@
 
 
 #include <stdint.h>
+#include <stddef.h>
 #include <Printable.h>
 #include <Print.h>
 
@@ -124,13 +125,51 @@ typedef Print print_t;
      *  Hence a local tm structure will return a local time stamp and
      *  a UTC tm structure will return a UTC time stamp.
      *
+     *  Dates from 1970 to 2199 are converted by DCF77calendar, others by
+     *  a generic fallback if the C library time functions are available.
+     *  Without the C library time functions,
+     *  e.g. on AVR, the date must lie between 1970-01-01 and 2106-02-07,
+     *  the range of the 32 bit time stamp. It isn't checked.
+     *
      *  @param[in] tm the tm structure to be converted
      *  @return the time stamp result.
      *  */
     DCF77::time_t tm_to_timestamp(const DCF77::tm& tm);
 
     /**
-     * Print a tm structure on print_t interface, which
+     * The text layouts of format_tm() and print_tm().
+     *
+     * ASCTIME: "Thu Oct 16 12:34:56 2026", like asctime() without the
+     *  trailing new line.
+     * ISO8601: "2026-10-16T12:34:56", the ISO 8601 extended format
+     *  without time zone.
+     */
+    enum TM_FORMAT : uint8_t {ASCTIME, ISO8601};
+
+    /**
+     * The buffer size for format_tm(), including the terminating zero.
+     */
+    static constexpr size_t TM_FORMAT_SIZE = 25;
+
+    /**
+     * Render a tm structure into a buffer. Nothing is allocated and no
+     * locale is consulted. The year must be within 0 and 9999.
+     *
+     * @param[out] buffer The text, terminated by zero.
+     * @param[in] time The time to be rendered.
+     * @param[in] format The layout.
+     * @return The number of characters without the terminating zero.
+     *
+     * Example:
+     *   char text[DCF77::TM_FORMAT_SIZE];
+     *   DCF77::format_tm(text, tm, DCF77::ISO8601);
+     */
+    size_t format_tm(char (&buffer)[TM_FORMAT_SIZE], const DCF77::tm& time,
+        TM_FORMAT format = ASCTIME);
+
+    /**
+     * Print a tm structure on print_t interface. The text is rendered
+     * by format_tm() and written with a single call of write().
      *
      * @return The number of printed characters.
      *
@@ -147,7 +186,7 @@ typedef Print print_t;
      *
      *   print_tm(Serial, tm);
      */
-    size_t print_tm(print_t& p, const DCF77::tm& time);
+    size_t print_tm(print_t& p, const DCF77::tm& time, TM_FORMAT format = ASCTIME);
   }
 
 #endif /* DCF77tm_H_ */
@@ -0,0 +1,212 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77trace_H_
+#define DCF77trace_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <Arduino.h>
+#include "internal/ISR_ATTR.h"
+
+template<typename DERIVED, int RECEIVER_PIN, typename POLICY> class DCF77rxStatic;
+
+/**
+ * DCF77trace records the edges of a receiver pin, to reproduce field
+ * problems on the host. Every edge is stored as its level and the time
+ * since the previous edge in a ring buffer. When the ring is full, the
+ * oldest edges are overwritten.
+ *
+ * An edge takes 1 byte for less than 64 ticks since the previous edge,
+ * 2 bytes for less than 8192 ticks and one more byte for every further
+ * 7 bits. With millis() time stamps, the regular pulses take 2 bytes
+ * per edge, so a buffer of 1kB holds the latest 4 minutes.
+ *
+ * DCF77traceBuffer<1024> trace;
+ * MyDcf77Receiver receiver;
+ *
+ * void setup() {
+ *   receiver.attachTrace(trace);
+ *   receiver.begin();
+ * }
+ *
+ * void loop() {
+ *   if (Serial.read() == 'd') {
+ *     trace.dump(Serial);
+ *   }
+ * }
+ *
+ * The dump is text and can be replayed on the host by extras/replay.
+ * Its format is:
+ *
+ * DCF77TRACE 1 <ticks per ms> <base time> <edges> <dropped edges>
+ * <the ring content as hex digits, 32 bytes per line>
+ * END
+ *
+ * The time of the first edge is the base time plus its delta.
+ */
+class DCF77trace {
+public:
+  static constexpr uint8_t MAX_RECORD_BYTES = 5;
+
+  /**
+   * Resume recording. A trace records from its construction on.
+   */
+  void start() {
+    mRecording = true;
+  }
+
+  /**
+   * Stop recording. The recorded edges are kept.
+   */
+  void stop() {
+    mRecording = false;
+  }
+
+  bool isRecording() const {
+    return mRecording;
+  }
+
+  /**
+   * Delete the recorded edges. Must not be called while recording.
+   */
+  void clear();
+
+  /**
+   * Record an edge. To be called by the pin interrupt handler.
+   *
+   * @param[in] level The level of the pin after the edge.
+   * @param[in] time The time stamp of the edge in ticks of the time
+   *  source of the receiver.
+   */
+  TEXT_ISR_ATTR_2
+  void record(const int level, const uint32_t time);
+
+  /** The number of edges in the ring. */
+  size_t edgeCount() const {
+    return mEdges;
+  }
+
+  /** The number of bytes in use. */
+  size_t byteCount() const {
+    return mUsed;
+  }
+
+  /** The number of edges that were overwritten by newer ones. */
+  uint32_t droppedCount() const {
+    return mDropped;
+  }
+
+  /**
+   * Write the trace to out. Recording is paused meanwhile, the edges
+   * of that time are lost.
+   *
+   * @return The number of characters written.
+   */
+  size_t dump(Print& out);
+
+protected:
+  DCF77trace(uint8_t* buffer, size_t capacity)
+    : mBuffer(buffer), mCapacity(capacity) {
+  }
+
+private:
+  template<typename DERIVED, int RECEIVER_PIN, typename POLICY> friend class DCF77rxStatic;
+
+  TEXT_ISR_ATTR_3
+  void dropOldest();
+
+  TEXT_ISR_ATTR_3_INLINE
+  uint8_t takeOldestByte() {
+    const uint8_t byte = mBuffer[mTail];
+    if (++mTail == mCapacity) {
+      mTail = 0;
+    }
+    mUsed--;
+    return byte;
+  }
+
+  uint8_t* const mBuffer;
+  const size_t mCapacity;
+  /* Write position, read position and bytes in use. */
+  size_t mHead = 0;
+  size_t mTail = 0;
+  size_t mUsed = 0;
+  size_t mEdges = 0;
+  uint32_t mDropped = 0;
+  /* The time of the edge before the oldest one in the ring. */
+  uint32_t mBaseTime = 0;
+  uint32_t mLatestTime = 0;
+  uint16_t mTicksPerMilli = 1;
+  volatile bool mRecording = true;
+};
+
+/**
+ * A DCF77trace with CAPACITY bytes of storage.
+ */
+template<size_t CAPACITY> class DCF77traceBuffer : public DCF77trace {
+  static_assert(CAPACITY >= 4 * MAX_RECORD_BYTES, "CAPACITY is too small");
+
+public:
+  DCF77traceBuffer() : DCF77trace(mStorage, CAPACITY) {
+  }
+
+private:
+  uint8_t mStorage[CAPACITY];
+};
+
+/**
+ * Decodes the edges of a trace, that has been read back from a dump.
+ */
+class DCF77traceReader {
+public:
+  /**
+   * @param[in] data The ring content of the dump.
+   * @param[in] size The number of bytes.
+   * @param[in] baseTime The base time of the dump.
+   */
+  DCF77traceReader(const uint8_t* data, size_t size, uint32_t baseTime)
+    : mData(data), mSize(size), mTime(baseTime) {
+  }
+
+  /**
+   * Decode the next edge.
+   *
+   * @param[out] level The level of the pin after the edge.
+   * @param[out] time The time stamp of the edge.
+   * @return false at the end of the trace or if the last edge is
+   *  truncated.
+   */
+  bool next(int& level, uint32_t& time);
+
+private:
+  const uint8_t* mData;
+  size_t mSize;
+  size_t mPosition = 0;
+  uint32_t mTime;
+};
+
+#endif /* DCF77trace_H_ */
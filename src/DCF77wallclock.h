@@ -0,0 +1,253 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77wallclock_H_
+#define DCF77wallclock_H_
+
+#include <stdint.h>
+#include "DCF77tm.h"
+#include "DCF77frameSlot.h"
+#include "internal/ISR_ATTR.h"
+
+#ifndef ARDUINO_ARCH_AVR
+#define HAS_STD_CHRONO true
+#endif
+
+#if HAS_STD_CHRONO
+#include <chrono>
+#endif
+
+/**
+ * The largest frequency error of the system tick, that the wall clock
+ * corrects. A measurement beyond it is taken for a wrong frame.
+ * Ceramic resonators are within a few thousand ppm.
+ */
+#ifndef DCF77_MAX_DRIFT_PPM
+#define DCF77_MAX_DRIFT_PPM 5000
+#endif
+
+/**
+ * A software clock, that is set from received dcf77 frames and runs on
+ * the system tick in between.
+ *
+ * A frame is converted only once, when the time is read for the first
+ * time after the frame has been received. The resulting time stamp and
+ * tm structure are cached. Reading the time again within the same second
+ * returns the cached tm structure. When a second boundary is crossed,
+ * the cached tm structure is advanced incrementally. A full conversion
+ * is only done when a day boundary is crossed.
+ *
+ * The clock needs a frame update at least every 2**32 milliseconds,
+ * which is approximately every 49 days. Otherwise there will be a
+ * systick overrun.
+ *
+ * The frequency error of the system tick is estimated from the minute
+ * marks of consecutive frames and corrected, when the time is
+ * extrapolated from the latest frame. This keeps the clock accurate
+ * during a signal outage, even if the board runs on a ceramic
+ * resonator. driftPpm() reports the estimate and holdoverErrorMillis()
+ * a bound of the error accumulated since the latest frame.
+ *
+ * Usage:
+ *
+ * class MyDcf77Receiver : public DCF77rx<DCF77_PIN> {
+ *   void onDCF77FrameReceived(const uint64_t dcf77frame, const uint32_t systick) override {
+ *     wallclock.update(dcf77frame, systick);
+ *   }
+ * public:
+ *   DCF77wallclock wallclock;
+ * };
+ *
+ * void loop() {
+ *   PrintableDCF77tm tm;
+ *   if (myReceiver.wallclock.getTime(tm)) {
+ *     Serial.println(tm);
+ *   }
+ * }
+ */
+class DCF77wallclock {
+public:
+  /**
+   * Set the clock from a received frame. Only stores the frame, so it
+   * is cheap enough to be called from onDCF77FrameReceived() within
+   * the interrupt context.
+   *
+   * @param[in] dcf77frame The received frame.
+   * @param[in] systick The millis() time stamp of the frame's minute mark.
+   */
+  TEXT_ISR_ATTR_4
+  void update(const uint64_t dcf77frame, const uint32_t systick);
+
+  /**
+   * Read the current local time.
+   *
+   * @param[out] tm The actual time.
+   * @param[out] millisec The number of expired milliseconds
+   *  within the current second.
+   *
+   * @return false, as long as no Dcf77 frame was received.
+   */
+  bool getTime(DCF77::tm& tm, unsigned* millisec = nullptr);
+
+  /**
+   * Read the current local time as time stamp.
+   *
+   * @param[out] timestamp The local time stamp.
+   * @param[out] millisec The number of expired milliseconds
+   *  within the current second.
+   *
+   * @return false, as long as no Dcf77 frame was received.
+   */
+  bool getTimestamp(DCF77::time_t& timestamp, unsigned* millisec = nullptr);
+
+  /**
+   * Offset of the local time to UTC in seconds. 3600 for CET and
+   * 7200 for CEST. Valid when getTime() or getTimestamp() returned true.
+   */
+  int32_t utcOffset() const {
+    return mCachedTm.tm_isdst ? 7200 : 3600;
+  }
+
+  /**
+   * The estimated frequency error of the system tick in ppm. Positive,
+   * if the system tick runs fast. Valid once hasDriftEstimate() is true.
+   */
+  float driftPpm() const {
+    return mDriftPpmQ8 / 256.0f;
+  }
+
+  /**
+   * Two frames have been received that allowed to estimate the drift.
+   */
+  bool hasDriftEstimate() const {
+    return mDriftCount != 0;
+  }
+
+  /**
+   * A bound of the time error accumulated since the latest frame. It
+   * grows with the uncertainty of the drift estimate, or with
+   * DCF77_MAX_DRIFT_PPM as long as there is no estimate. Valid when
+   * getTime() or getTimestamp() returned true.
+   *
+   * @return The error bound in milliseconds.
+   */
+  uint32_t holdoverErrorMillis() const;
+
+  /**
+   * The time from the latest frame, until holdoverErrorMillis() reaches
+   * maxErrorMillis. This is how long the clock can run without frame.
+   * Valid when getTime() or getTimestamp() returned true.
+   *
+   * @param[in] maxErrorMillis The acceptable error bound.
+   * @return The holdover time in milliseconds.
+   */
+  uint32_t holdoverMillis(const uint32_t maxErrorMillis) const;
+
+  /**
+   * The number of frames passed to update(). A change tells that a
+   * frame has been received.
+   */
+  uint32_t frameCount() const {
+    return mLatestFrame.sequence();
+  }
+
+private:
+  /**
+   * The bound of the drift estimate error in ppm with 8 fractional bits.
+   */
+  int64_t driftBoundQ8() const;
+
+  /**
+   * Update the drift estimate with the interval between two frames.
+   *
+   * @param[in] seconds The UTC seconds between the minute marks.
+   * @param[in] ticks The system ticks between the minute marks.
+   */
+  void discipline(const uint32_t seconds, const uint32_t ticks);
+
+  /**
+   * Take over a newly received frame and advance the cache to the
+   * current second.
+   *
+   * @return false, if no frame has been received yet.
+   */
+  bool refresh(unsigned* millisec);
+
+  /* Written by update(), possibly within the interrupt context. */
+  DCF77frameSlot mLatestFrame;
+
+  /* The cache, only accessed by the readers. */
+  uint32_t mFrameCountSeen = 0;
+  bool mValid = false;
+  uint32_t mSystickAtBase = 0;
+  DCF77::time_t mBaseTimestamp = 0;
+  DCF77::time_t mBaseUtc = 0;
+  /* The drift estimate and the mean deviation of the measurements
+   * from it, both in ppm with 8 fractional bits. */
+  int32_t mDriftPpmQ8 = 0;
+  int32_t mDriftSpreadQ8 = 0;
+  uint8_t mDriftCount = 0;
+  /* The correction of the elapsed ticks in units of 2**-32. */
+  int32_t mRateAdjust = 0;
+  /* Seconds since base, that mCachedTm refers to. */
+  uint32_t mCachedSeconds = 0;
+  /* Milliseconds since base, when the cached second began. */
+  uint32_t mCachedSecondStart = 0;
+  DCF77::tm mCachedTm = DCF77::tm();
+};
+
+#if HAS_STD_CHRONO
+/**
+ * A clock that meets the C++ TrivialClock requirements, reading the
+ * time from a DCF77wallclock. Like std::chrono::system_clock it counts
+ * UTC time since 1970-01-01 and is not steady. Before the first frame
+ * has been received, now() returns the epoch.
+ *
+ * Usage:
+ *   DCF77chronoClock::setSource(myReceiver.wallclock);
+ *   const DCF77chronoClock::time_point t = DCF77chronoClock::now();
+ */
+class DCF77chronoClock {
+public:
+  using rep = int64_t;
+  using period = std::milli;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<DCF77chronoClock>;
+  static constexpr bool is_steady = false;
+
+  static time_point now() noexcept;
+
+  /** Select the wall clock that now() reads. */
+  static void setSource(DCF77wallclock& wallclock) {
+    mSource = &wallclock;
+  }
+
+private:
+  static DCF77wallclock* mSource;
+};
+#endif
+
+#endif /* DCF77wallclock_H_ */
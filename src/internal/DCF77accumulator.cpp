@@ -0,0 +1,291 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77accumulator.h"
+#include "DCF77calendar.h"
+
+constexpr int8_t DCF77accumulator::MAX_SCORE;
+constexpr int8_t DCF77accumulator::DISCARD_SCORE;
+constexpr uint16_t DCF77accumulator::UNKNOWN_AGE;
+
+namespace {
+
+using namespace DCF77frame;
+
+constexpr uint32_t MINUTE_MILLIS = 60000UL;
+/* A minute mark must be this close to a whole number of minutes after
+   the previous one. A lost pulse shifts the mark by whole seconds. */
+constexpr uint32_t MARK_TOLERANCE_MILLIS = 500UL;
+constexpr uint32_t SECS_PER_HOUR = 3600UL;
+constexpr uint16_t MINUTES_PER_DAY = 24 * 60;
+
+/* The bits that follow from the time: Z1, Z2, S, time and date. */
+constexpr uint64_t PREDICTABLE = Z1::frameMask() | Z2::frameMask() | S::frameMask()
+    | MinSection::frameMask() | HourSection::frameMask() | DateSection::frameMask();
+
+/**
+ * Decode a BCD field, whose digits must not exceed 9.
+ *
+ * @return The value or 0xFF if a digit is invalid.
+ */
+template<typename FIELD> uint8_t bcdValue(const uint64_t bits) {
+  const uint32_t bcd = FIELD::extract(bits);
+  if ((bcd & 0x0F) > 9 || (bcd >> 4) > 9) {
+    return 0xFF;
+  }
+  return static_cast<uint8_t>((bcd >> 4) * 10 + (bcd & 0x0F));
+}
+
+/**
+ * The number of whole minutes in elapsed ticks.
+ *
+ * @return 0 if elapsed isn't within MARK_TOLERANCE_MILLIS of at least
+ *  one minute.
+ */
+inline uint32_t wholeMinutes(const uint32_t elapsed, const uint16_t ticksPerMilli) {
+  const uint32_t ticksPerMinute = MINUTE_MILLIS * ticksPerMilli;
+  const uint32_t toleranceTicks = MARK_TOLERANCE_MILLIS * ticksPerMilli;
+  const uint32_t minutes = (elapsed + toleranceTicks) / ticksPerMinute;
+  return elapsed + toleranceTicks - minutes * ticksPerMinute <= 2 * toleranceTicks ? minutes : 0;
+}
+
+inline uint16_t older(const uint16_t age, const uint32_t minutes, const uint16_t unknown) {
+  return age == unknown || minutes >= static_cast<uint32_t>(unknown - age) ? unknown : age + minutes;
+}
+
+inline uint8_t minuteOfHour(const uint32_t localTime) {
+  uint32_t secondOfDay;
+  DCF77calendar::days_from_timestamp(localTime, secondOfDay);
+  uint8_t hour, minute, second;
+  DCF77calendar::hms_from_seconds(secondOfDay, hour, minute, second);
+  return minute;
+}
+
+} // anonymous namespace
+
+DCF77accumulator::DCF77accumulator(uint8_t lockThreshold)
+  : mLockThreshold(lockThreshold < 1 ? 1 : (lockThreshold > MAX_SCORE ? MAX_SCORE : lockThreshold)) {
+  for (size_t i = 0; i < BIT_COUNT; i++) {
+    mScore[i] = 0;
+  }
+}
+
+int8_t DCF77accumulator::agreement() const {
+  if (not mHasCandidate) {
+    return 0;
+  }
+  int8_t result = MAX_SCORE;
+  for (uint8_t i = 0; i < BIT_COUNT; i++) {
+    if (((PREDICTABLE >> i) & 1) && mScore[i] < result) {
+      result = mScore[i];
+    }
+  }
+  return result;
+}
+
+void DCF77accumulator::onMinuteSync(const uint64_t bits, const size_t bitCount, const uint32_t systick,
+    const uint16_t ticksPerMilli) {
+  if (mHasSystick) {
+    const uint32_t elapsed = systick - mSystick;
+    uint32_t minutes = wholeMinutes(elapsed, ticksPerMilli);
+    if (minutes == 0) {
+      // A lost pulse within the minute is taken for a minute mark by
+      // the receiver. Only a second stray mark, that agrees with the
+      // first and ends a complete minute, proves the grid wrong.
+      const bool regrid = mHasStrayMark && bitCount == BIT_COUNT
+          && wholeMinutes(systick - mStrayMark, ticksPerMilli) != 0;
+      mHasStrayMark = true;
+      mStrayMark = systick;
+      if (not regrid) {
+        return;
+      }
+      const uint32_t ticksPerMinute = MINUTE_MILLIS * ticksPerMilli;
+      minutes = (elapsed + ticksPerMinute / 2) / ticksPerMinute;
+    }
+    advance(minutes);
+  }
+  mHasSystick = true;
+  mSystick = systick;
+
+  // A minute with a spurious pulse or a leap second has more bits
+  // and is skipped, since it is unknown where the bits are shifted.
+  if (bitCount == BIT_COUNT) {
+    collectSections(bits);
+    if (mHasCandidate) {
+      if (A1::extract(bits)) {
+        mA1Score += mA1Score < MAX_SCORE;
+      } else {
+        mA1Score -= mA1Score > -MAX_SCORE;
+      }
+      mPredicted = (mPredicted & ~A1::frameMask()) | A1::insert(mA1Score > 0);
+      compare(bits);
+    } else if (assembleCandidate()) {
+      // The sections of this minute count as the first agreement.
+      compare(bits);
+    }
+  }
+
+  if (mLocked) {
+    onDCF77FrameReceived(mPredicted, systick);
+  }
+}
+
+void DCF77accumulator::advance(const uint32_t minutes) {
+  mMinuteAge = older(mMinuteAge, minutes, UNKNOWN_AGE);
+  mHourAge = older(mHourAge, minutes, UNKNOWN_AGE);
+  mDateAge = older(mDateAge, minutes, UNKNOWN_AGE);
+
+  if (not mHasCandidate) {
+    return;
+  }
+  const bool newHour = minuteOfHour(mCandidate) + minutes >= 60;
+  mCandidate += minutes * 60;
+  if (newHour) {
+    // The change is announced during the hour before.
+    if (mA1Score > 0) {
+      mCandidateIsdst = !mCandidateIsdst;
+      mIsdst = mCandidateIsdst;
+      if (mCandidateIsdst) {
+        mCandidate += SECS_PER_HOUR;
+      } else {
+        mCandidate -= SECS_PER_HOUR;
+      }
+    }
+    mA1Score = 0;
+  }
+  predict();
+}
+
+void DCF77accumulator::collectSections(const uint64_t bits) {
+  if (parityOk<MinSection>(bits)) {
+    const uint8_t minute = bcdValue<Min>(bits);
+    if (minute < 60) {
+      mMinute = minute;
+      mMinuteAge = 0;
+    }
+  }
+
+  if (parityOk<HourSection>(bits)) {
+    const uint8_t hour = bcdValue<Hour>(bits);
+    if (hour < 24) {
+      mHour = hour;
+      mHourAge = 0;
+    }
+  }
+
+  if (parityOk<DateSection>(bits)) {
+    const uint8_t mday = bcdValue<Day>(bits);
+    const uint8_t month = bcdValue<Month>(bits);
+    const uint8_t year = bcdValue<Year>(bits);
+    if (mday >= 1 && mday <= 31 && month >= 1 && month <= 12 && year <= 99) {
+      const uint32_t days = DCF77calendar::days_from_civil(2000 + year, month, mday);
+      const DCF77calendar::civil_t civil = DCF77calendar::civil_from_days(days);
+      const uint8_t wday = civil.wday == 0 ? 7 : civil.wday;
+      // Rejects e.g. February 30th and a wrong weekday.
+      if (civil.mday == mday && wday == Weekday::extract(bits)) {
+        mDays = static_cast<uint16_t>(days);
+        mDateAge = 0;
+      }
+    }
+  }
+
+  if (Z1::extract(bits) != Z2::extract(bits)) {
+    mIsdst = Z1::extract(bits);
+  }
+}
+
+bool DCF77accumulator::assembleCandidate() {
+  if (mMinuteAge == UNKNOWN_AGE || mHourAge == UNKNOWN_AGE
+      || mDateAge == UNKNOWN_AGE || mIsdst < 0) {
+    return false;
+  }
+
+  // Move every section to the current minute, the carry of the hour
+  // and the date follows from the current minute.
+  const uint16_t minute = (mMinute + mMinuteAge) % 60;
+  const uint16_t minuteAtHour = (minute + 60 - mHourAge % 60) % 60;
+  const uint32_t hourMinutes = static_cast<uint32_t>(mHour) * 60 + minuteAtHour + mHourAge;
+  const uint16_t minuteOfDay = hourMinutes % MINUTES_PER_DAY;
+  const uint16_t minuteAtDate = (minuteOfDay + MINUTES_PER_DAY - mDateAge % MINUTES_PER_DAY) % MINUTES_PER_DAY;
+  const uint32_t days = mDays + (static_cast<uint32_t>(minuteAtDate) + mDateAge) / MINUTES_PER_DAY;
+
+  mCandidate = days * DCF77calendar::SECS_PER_DAY + static_cast<uint32_t>(minuteOfDay) * 60;
+  mCandidateIsdst = mIsdst;
+  mHasCandidate = true;
+  mA1Score = 0;
+  for (size_t i = 0; i < BIT_COUNT; i++) {
+    mScore[i] = 0;
+  }
+  predict();
+  return true;
+}
+
+void DCF77accumulator::predict() {
+  DCF77::tm time;
+  DCF77::timestamp_to_tm(time, mCandidate, mCandidateIsdst);
+  mPredicted = DCF77rxbase::dcf77time2frame(time) | A1::insert(mA1Score > 0);
+}
+
+void DCF77accumulator::compare(const uint64_t bits) {
+  const uint64_t differences = (bits ^ mPredicted) & PREDICTABLE;
+  int8_t lowest = MAX_SCORE;
+  uint8_t lowestBit = 0;
+  for (uint8_t i = 0; i < BIT_COUNT; i++) {
+    if (not ((PREDICTABLE >> i) & 1)) {
+      continue;
+    }
+    int8_t score = mScore[i];
+    if ((differences >> i) & 1) {
+      score--;
+    } else if (score < MAX_SCORE) {
+      score++;
+    }
+    mScore[i] = score;
+    if (score < lowest) {
+      lowest = score;
+      lowestBit = i;
+    }
+  }
+
+  if (lowest <= DISCARD_SCORE) {
+    discardCandidate(lowestBit);
+  } else {
+    mLocked = lowest >= static_cast<int8_t>(mLockThreshold);
+  }
+}
+
+void DCF77accumulator::discardCandidate(const uint8_t bit) {
+  // The section of the disagreeing bit is wrong, the others may be fine.
+  if (bit >= MinSection::pos && bit < MinSection::pos + MinSection::width) {
+    mMinuteAge = UNKNOWN_AGE;
+  } else if (bit >= HourSection::pos && bit < HourSection::pos + HourSection::width) {
+    mHourAge = UNKNOWN_AGE;
+  } else if (bit >= DateSection::pos) {
+    mDateAge = UNKNOWN_AGE;
+  } else {
+    mIsdst = -1;
+  }
+  mHasCandidate = false;
+  mLocked = false;
+}
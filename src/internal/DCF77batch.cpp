@@ -0,0 +1,124 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77rxbase.h"
+#include "DCF77frame.h"
+
+/**
+ * Direct and batch conversion of dcf77 frames. Every field is extracted
+ * with shifts and masks from the 64 bit frame, so that each loop
+ * iteration is independent and free of branches.
+ */
+
+namespace {
+
+using namespace DCF77frame;
+
+/* 2000-03-01 is day 11017 since 1970-01-01. */
+constexpr int32_t DAYS_1970_TO_2000_03_01 = 11017L;
+constexpr int32_t SECSPERDAY = 86400L;
+
+/**
+ * Decode a BCD field arithmetically. Unlike a table look up this maps
+ * to plain vector instructions.
+ */
+template<typename FIELD> inline uint32_t bcdField(uint64_t frame) {
+  const uint32_t bcd = FIELD::extract(frame);
+  return bcd - (bcd >> 4) * 6;
+}
+
+/**
+ * Days since 1970-01-01 for a date in the years 2000 to 2099, where every
+ * 4th year is a leap year. The year is counted from March, so that the
+ * leap day is the last day of the year.
+ *
+ * @param year2 The year 0..99 since 2000.
+ * @param month The month 1..12.
+ * @param mday The day of month 1..31.
+ */
+inline int32_t daysSince1970(uint32_t year2, uint32_t month, uint32_t mday) {
+  const uint32_t janOrFeb = month < 3;
+  const uint32_t marchMonth = month + 12 * janOrFeb - 3;     /* [0, 11] */
+  const uint32_t marchYear = year2 + 4 - janOrFeb;           /* [3, 103] */
+  const uint32_t yearDay = ((979 * marchMonth + 15) >> 5) + mday - 1;
+  const int32_t days = 365 * marchYear + (marchYear >> 2) + yearDay;
+  return days - (4 * 365 + 1) + DAYS_1970_TO_2000_03_01;
+}
+
+/**
+ * The UTC time stamp of a frame. CET is UTC+1, CEST (Z1 set) is UTC+2.
+ */
+inline DCF77::time_t frameToUtc(const uint64_t frame) {
+  const int32_t days = daysSince1970(bcdField<Year>(frame),
+      bcdField<Month>(frame), bcdField<Day>(frame));
+  const int32_t secs = static_cast<int32_t>(bcdField<Hour>(frame) * 3600
+      + bcdField<Min>(frame) * 60)
+      - 3600 * static_cast<int32_t>(1 + Z1::extract(frame));
+  return static_cast<DCF77::time_t>(days) * SECSPERDAY + secs;
+}
+
+template<typename FIELD, bool BCD> void decodeField(uint8_t *__restrict__ dst,
+    const uint64_t *__restrict__ dcf77frames, size_t count, uint32_t offset) {
+  if (dst == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t v = BCD ? bcdField<FIELD>(dcf77frames[i]) : FIELD::extract(dcf77frames[i]);
+    dst[i] = static_cast<uint8_t>(v + offset);
+  }
+}
+
+} // anonymous namespace
+
+void DCF77rxbase::dcf77frames2fields(const DCF77frameFields& fields,
+    const uint64_t* dcf77frames, size_t count) {
+  decodeField<Min,   true >(fields.tm_min,   dcf77frames, count, 0);
+  decodeField<Hour,  true >(fields.tm_hour,  dcf77frames, count, 0);
+  decodeField<Day,   true >(fields.tm_mday,  dcf77frames, count, 0);
+  decodeField<Month, true >(fields.tm_mon,   dcf77frames, count, static_cast<uint32_t>(-1));
+  decodeField<Year,  true >(fields.tm_year,  dcf77frames, count, 100);
+  decodeField<Z1,    false>(fields.tm_isdst, dcf77frames, count, 0);
+
+  if (fields.tm_wday != nullptr) {
+    uint8_t *__restrict__ wday = fields.tm_wday;
+    for (size_t i = 0; i < count; i++) {
+      // Weekday is 1 (Monday) to 7 (Sunday). Map Sunday to 0.
+      const uint32_t v = Weekday::extract(dcf77frames[i]);
+      wday[i] = static_cast<uint8_t>(v - 7 * (v == 7));
+    }
+  }
+}
+
+void DCF77rxbase::dcf77frames2utc(DCF77::time_t* utc,
+    const uint64_t* dcf77frames, size_t count) {
+  DCF77::time_t *__restrict__ dst = utc;
+  const uint64_t *__restrict__ src = dcf77frames;
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = frameToUtc(src[i]);
+  }
+}
+
+DCF77::time_t DCF77rxbase::dcf77frame2utc(const uint64_t dcf77frame) {
+  return frameToUtc(dcf77frame);
+}
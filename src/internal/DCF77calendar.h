@@ -0,0 +1,159 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_CALENDAR_H_
+#define DCF77_INTERNAL_DCF77_CALENDAR_H_
+
+#include <stdint.h>
+
+/**
+ * Division free calendar kernels in the style of the Euclidean affine
+ * functions of C. Neri and L. Schneider, "Euclidean affine functions and
+ * their application to calendar algorithms" (2022).
+ *
+ * Every division by a constant is replaced by a multiplication and a
+ * shift, which is exact within the supported range, in some places
+ * followed by a single correction step. Except for the split of a time
+ * stamp into days, all products fit into 32 bits, which keeps them cheap
+ * on 8 bit targets without hardware divide.
+ *
+ * civil_from_days() supports the days 0 (1970-01-01) to MAX_DAYS
+ * (2149-06-06), which covers the full range of an unsigned 32 bit time
+ * stamp. days_from_civil() supports the dates 1970-01-01 to 2199-12-31,
+ * the range of tm_to_timestamp(). Its result exceeds MAX_DAYS beyond
+ * 2149-06-06 and is therefore a uint32_t.
+ */
+namespace DCF77calendar {
+
+  static constexpr uint32_t MAX_DAYS = 65535;
+  static constexpr uint32_t SECS_PER_DAY = 86400;
+
+  /**
+   * The kernels count days in a calendar whose years start on March 1st
+   * and which has a leap day every 4 years. Day 0 is 1968-03-01, day
+   * DAYS_1968_03_01_TO_1970 is 1970-01-01. Since 2100 isn't a leap year,
+   * a phantom leap day 2100-02-29 is inserted into this calendar.
+   */
+  static constexpr uint32_t DAYS_1968_03_01_TO_1970 = 671;
+  static constexpr uint32_t PHANTOM_2100_02_29 = 48212;
+  static constexpr uint32_t DAYS_PER_4_YEARS = 3 * 365 + 366;
+
+  struct civil_t {
+    uint16_t year;  // anno domini
+    uint8_t month;  // [1, 12]
+    uint8_t mday;   // [1, 31]
+    uint16_t yday;  // [0, 365]
+    uint8_t wday;   // [0, 6], 0 = Sunday
+  };
+
+  /**
+   * Days since 1970-01-01 for a date between 1970-01-01 and 2199-12-31.
+   * 2200 isn't a leap year, but isn't corrected like 2100.
+   *
+   * @param year The anno domini year.
+   * @param month The month [1, 12].
+   * @param mday The day of month [1, 31].
+   */
+  inline uint32_t days_from_civil(const uint16_t year, const uint8_t month, const uint8_t mday) {
+    const uint32_t janOrFeb = month <= 2;
+    const uint32_t marchYear = year - 1968 - janOrFeb;
+    const uint32_t marchMonth = month + 12 * janOrFeb;  /* [3, 14] */
+    const uint32_t days = 365 * marchYear + (marchYear >> 2)
+        + ((979 * marchMonth - 2919) >> 5) + mday - 1;
+    return days - DAYS_1968_03_01_TO_1970 - (days > PHANTOM_2100_02_29);
+  }
+
+  /**
+   * Date for days since 1970-01-01. The inverse of days_from_civil().
+   *
+   * @param days The days since 1970-01-01 [0, MAX_DAYS].
+   */
+  inline civil_t civil_from_days(const uint32_t days) {
+    uint32_t n = days + DAYS_1968_03_01_TO_1970;
+    n += n >= PHANTOM_2100_02_29;
+
+    /* 4 year cycles: n / 1461, the estimate is at most one too small. */
+    uint32_t cycle = (n * 2870) >> 22;
+    uint32_t cycleDay = n - DAYS_PER_4_YEARS * cycle;
+    if (cycleDay >= DAYS_PER_4_YEARS) {
+      cycle++;
+      cycleDay -= DAYS_PER_4_YEARS;
+    }
+
+    /* Year within the cycle: (4 * cycleDay + 3) / 1461 */
+    const uint32_t cycleYear = (cycleDay * 359 + 111) >> 17;      /* [0, 3] */
+    const uint32_t marchYearDay = cycleDay - 365 * cycleYear;     /* [0, 365] */
+
+    /* Month and day of month: See Neri and Schneider, section 5. */
+    const uint32_t n3 = 2141 * marchYearDay + 197913;
+    const uint32_t marchMonth = n3 >> 16;                         /* [3, 14] */
+    const uint32_t janOrFeb = marchYearDay >= 306;
+
+    civil_t civil;
+    civil.year = static_cast<uint16_t>(1968 + 4 * cycle + cycleYear + janOrFeb);
+    civil.month = static_cast<uint8_t>(marchMonth - 12 * janOrFeb);
+    civil.mday = static_cast<uint8_t>((((n3 & 0xFFFF) * 31345) >> 26) + 1);
+
+    /* Cycle year 0 starts on March 1st of a leap year. */
+    const uint32_t leapYear = cycleYear == 0 && civil.year != 2100;
+    civil.yday = static_cast<uint16_t>(janOrFeb ? marchYearDay - 306 : marchYearDay + 59 + leapYear);
+
+    /* 1970-01-01 was a Thursday: (days + 4) % 7 */
+    const uint32_t d = days + 4;
+    uint32_t week = (d * 4681) >> 15;
+    uint32_t wday = d - 7 * week;
+    if (wday >= 7) {
+      wday -= 7;
+    }
+    civil.wday = static_cast<uint8_t>(wday);
+    return civil;
+  }
+
+  /**
+   * Split a time stamp into days since 1970-01-01 and seconds of day.
+   * ts / 86400 is computed as (ts / 128) / 675 by multiplication with a
+   * 64 bit product. This is exact for every 32 bit ts.
+   */
+  inline uint32_t days_from_timestamp(const uint32_t ts, uint32_t& secondOfDay) {
+    const uint32_t days = static_cast<uint32_t>((static_cast<uint64_t>(ts >> 7) * 50903317) >> 35);
+    secondOfDay = ts - days * SECS_PER_DAY;
+    return days;
+  }
+
+  /**
+   * Split the seconds of day into hour, minute and second.
+   */
+  inline void hms_from_seconds(const uint32_t secondOfDay, uint8_t& hour, uint8_t& minute, uint8_t& second) {
+    const uint32_t h = (secondOfDay * 37283) >> 27;       /* / 3600 */
+    const uint32_t secondOfHour = secondOfDay - 3600 * h;
+    const uint32_t m = (secondOfHour * 2185) >> 17;       /* / 60 */
+    hour = static_cast<uint8_t>(h);
+    minute = static_cast<uint8_t>(m);
+    second = static_cast<uint8_t>(secondOfHour - 60 * m);
+  }
+}
+
+#endif /* DCF77_INTERNAL_DCF77_CALENDAR_H_ */
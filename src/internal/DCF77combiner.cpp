@@ -0,0 +1,108 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77combiner.h"
+
+constexpr uint8_t DCF77combiner::CONFIDENCE_RANGE_MILLIS;
+constexpr uint8_t DCF77combiner::NO_SLOT;
+constexpr uint8_t DCF77combiner::MIN_WEIGHTED_MARGIN;
+
+void DCF77combiner::reset() {
+  for (size_t i = 0; i < DCF77frame::BIT_COUNT; i++) {
+    mScore[i] = 0;
+  }
+  mSynced = 0;
+  mVoters = 0;
+}
+
+uint8_t DCF77combiner::attach() {
+  if (mSlotCount >= DCF77_COMBINER_RECEIVERS) {
+    return NO_SLOT;
+  }
+  return mSlotCount++;
+}
+
+void DCF77combiner::vote(const uint8_t slot, const size_t second, const uint8_t confidence) {
+  if (slot >= mSlotCount) {
+    return;
+  }
+  if (second < DCF77frame::BIT_COUNT) {
+    mConfidence[slot][second] = confidence;
+  }
+  // A second has passed since the minute mark of this receiver. The
+  // others, that didn't sync meanwhile, have missed the mark.
+  if (second >= 1 && (mSynced & (1 << slot)) != 0) {
+    conclude();
+  }
+}
+
+void DCF77combiner::onMinuteSync(const uint8_t slot, const uint64_t bits, const size_t bitCount,
+    const uint32_t systick) {
+  if (slot >= mSlotCount) {
+    return;
+  }
+  const uint8_t mask = static_cast<uint8_t>(1 << slot);
+  if ((mSynced & mask) != 0) {
+    // This receiver is already a minute ahead.
+    conclude();
+  }
+  if (mSynced == 0) {
+    mSystick = systick;
+  }
+  mSynced |= mask;
+
+  // The bit of a leap second is left out of the vote.
+  if (DCF77frame::completeMinute(bits, bitCount)) {
+    for (size_t i = 0; i < DCF77frame::BIT_COUNT; i++) {
+      const int16_t weight = mVoting == MAJORITY ? 1 : mConfidence[slot][i];
+      mScore[i] += (bits >> i) & 1 ? weight : -weight;
+    }
+    mVoters++;
+  }
+
+  if (mSynced == (1 << mSlotCount) - 1) {
+    conclude();
+  }
+}
+
+void DCF77combiner::conclude() {
+  bool valid = mVoters != 0;
+  uint64_t dcf77frame = 0;
+  const int16_t margin = mVoting == MAJORITY ? 1 : MIN_WEIGHTED_MARGIN;
+  for (size_t i = 0; i < DCF77frame::BIT_COUNT; i++) {
+    // A tie or a nearly cancelled vote can't be decided.
+    valid = valid && (mScore[i] >= margin || mScore[i] <= -margin);
+    if (mScore[i] > 0) {
+      dcf77frame |= static_cast<uint64_t>(1) << i;
+    }
+  }
+  const uint32_t systick = mSystick;
+  reset();
+
+  using namespace DCF77frame;
+  if (valid && parityOk<MinSection>(dcf77frame) && parityOk<HourSection>(dcf77frame)
+      && parityOk<DateSection>(dcf77frame)) {
+    onDCF77FrameReceived(dcf77frame, systick);
+  }
+}
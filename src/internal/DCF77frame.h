@@ -0,0 +1,130 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_FRAME_H_
+#define DCF77_INTERNAL_DCF77_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Descriptor of a field within a 64 bit dcf77 frame. Bit n of the frame
+ * has been received in second n of the minute.
+ *
+ * The field is extracted with a shift and a mask that are resolved at
+ * compile time. The shift is done on the 32 bit half word that contains
+ * the field, which avoids 64 bit shifts on 8 and 32 bit targets.
+ *
+ * @tparam POS The position of the least significant bit.
+ * @tparam WIDTH The number of bits.
+ */
+template<uint8_t POS, uint8_t WIDTH> struct DCF77field {
+  static constexpr uint8_t pos = POS;
+  static constexpr uint8_t width = WIDTH;
+  static constexpr uint32_t mask = (static_cast<uint32_t>(1) << WIDTH) - 1;
+
+  /* Offset of the 32 bit word that contains the field. */
+  static constexpr uint8_t wordPos = POS + WIDTH <= 32 ? 0 : (POS >= 32 ? 32 : 16);
+  static_assert(POS + WIDTH - wordPos <= 32, "Field must fit into a 32 bit word");
+
+  /** The raw field bits. */
+  static uint32_t extract(const uint64_t frame) {
+    return (static_cast<uint32_t>(frame >> wordPos) >> (POS - wordPos)) & mask;
+  }
+
+  /** The value placed into the field bits of a frame. */
+  static uint64_t insert(const uint32_t value) {
+    return static_cast<uint64_t>(value & mask) << POS;
+  }
+
+  /** The field bits as a mask in the frame. */
+  static constexpr uint64_t frameMask() {
+    return static_cast<uint64_t>(mask) << POS;
+  }
+};
+
+/**
+ * DCF77 time format
+ */
+namespace DCF77frame {
+  using R       = DCF77field<15, 1>;  // call bit, transmitter problem
+  using A1      = DCF77field<16, 1>;  // CET / CEST change announcement
+  using Z1      = DCF77field<17, 1>;  // Set to 1 when CEST is in effect
+  using Z2      = DCF77field<18, 1>;  // Set to 1 when CET  is in effect
+  using A2      = DCF77field<19, 1>;  // leap second announcement
+  using S       = DCF77field<20, 1>;  // start of time, always 1
+  using Min     = DCF77field<21, 7>;  // minutes
+  using P1      = DCF77field<28, 1>;  // parity minutes
+  using Hour    = DCF77field<29, 6>;  // hours
+  using P2      = DCF77field<35, 1>;  // parity hours
+  using Day     = DCF77field<36, 6>;  // day
+  using Weekday = DCF77field<42, 3>;  // day of week, 1 = Monday .. 7 = Sunday
+  using Month   = DCF77field<45, 5>;  // month
+  using Year    = DCF77field<50, 8>;  // year (last 2 digits)
+  using P3      = DCF77field<58, 1>;  // parity date
+
+  /** Number of bits in a frame without leap second. */
+  static constexpr uint8_t BIT_COUNT = 59;
+
+  /* The sections covered by the parity bits P1, P2 and P3. */
+  using MinSection  = DCF77field<21,  8>;  // Min, P1
+  using HourSection = DCF77field<29,  7>;  // Hour, P2
+  using DateSection = DCF77field<36, 23>;  // Day, Weekday, Month, Year, P3
+
+  /**
+   * Parity of a 32 bit word by xor folding.
+   *
+   * @return 1 if the number of set bits is odd, otherwise 0.
+   */
+  inline uint8_t parity(uint32_t v) {
+    v ^= v >> 16;
+    v ^= v >> 8;
+    v ^= v >> 4;
+    return (0x6996 >> (v & 0x0F)) & 1;
+  }
+
+  /**
+   * Check the even parity of a section including its parity bit.
+   */
+  template<typename SECTION> inline bool parityOk(const uint64_t frame) {
+    return parity(SECTION::extract(frame)) == 0;
+  }
+
+  /**
+   * Whether the bits received between two minute marks are a complete
+   * frame. A minute with a leap second, announced by A2, has a 60th bit,
+   * which is always 0. Leap seconds are inserted at the end of a month,
+   * so its frame is that of minute 0 of day 1. This keeps a minute with
+   * a spurious pulse, which shifted the bits, from passing as one.
+   */
+  inline bool completeMinute(const uint64_t bits, const size_t bitCount) {
+    return bitCount == BIT_COUNT
+        || (bitCount == BIT_COUNT + 1 && A2::extract(bits) && ((bits >> BIT_COUNT) & 1) == 0
+            && Min::extract(bits) == 0x00 && Day::extract(bits) == 0x01);
+  }
+}
+
+#endif /* DCF77_INTERNAL_DCF77_FRAME_H_ */
@@ -0,0 +1,100 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77matchedFilter.h"
+
+constexpr uint16_t DCF77matchedFilter::SAMPLES_PER_SECOND;
+constexpr uint8_t DCF77matchedFilter::PULSE_SAMPLES;
+constexpr uint16_t DCF77matchedFilter::EVALUATION_DELAY;
+
+namespace {
+
+inline uint16_t nextSlot(const uint16_t slot) {
+  return slot + 1 == DCF77matchedFilter::SAMPLES_PER_SECOND ? 0 : slot + 1;
+}
+
+} // anonymous namespace
+
+DCF77matchedFilter::DCF77matchedFilter() {
+  for (uint16_t i = 0; i < SAMPLES_PER_SECOND; i++) {
+    mLowScore[i] = 0;
+  }
+  for (uint16_t i = 0; i < sizeof(mHistory); i++) {
+    mHistory[i] = 0;
+  }
+}
+
+void DCF77matchedFilter::evaluate(Second& second) const {
+  int8_t mark = 0;
+  int8_t softBit = 0;
+  uint16_t slot = mPhase;
+  for (uint8_t i = 0; i < 2 * PULSE_SAMPLES; i++) {
+    const bool low = mHistory[slot >> 3] & (1 << (slot & 7));
+    const int8_t vote = low ? 1 : -1;
+    if (i < PULSE_SAMPLES) {
+      mark += vote;
+    } else {
+      softBit += vote;
+    }
+    slot = nextSlot(slot);
+  }
+  second.mSoftBit = softBit;
+  // mark counts the low samples less the high ones of the 100ms
+  // template. A mark with more than a quarter of its samples low is
+  // still a mark, while second 59 carries no mark at all.
+  second.mMarked = mark > -static_cast<int8_t>(PULSE_SAMPLES / 2);
+}
+
+void DCF77matchedFilter::trackPhase() {
+  // Sliding window sum of the low scores over one pulse width.
+  uint16_t window = 0;
+  uint16_t last = 0;
+  for (uint8_t i = 0; i < PULSE_SAMPLES; i++) {
+    window += mLowScore[last];
+    last = nextSlot(last);
+  }
+
+  uint16_t current = 0;
+  uint16_t best = 0;
+  uint16_t bestSlot = 0;
+  for (uint16_t first = 0; first < SAMPLES_PER_SECOND; first++) {
+    if (first == mPhase) {
+      current = window;
+    }
+    if (window > best) {
+      best = window;
+      bestSlot = first;
+    }
+    window += mLowScore[last];
+    window -= mLowScore[first];
+    last = nextSlot(last);
+  }
+
+  if (best > current) {
+    mPhase = bestSlot;
+    const uint16_t evaluationSlot = bestSlot + EVALUATION_DELAY;
+    mEvaluationSlot = evaluationSlot < SAMPLES_PER_SECOND ?
+        evaluationSlot : evaluationSlot - SAMPLES_PER_SECOND;
+  }
+}
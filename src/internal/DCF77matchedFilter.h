@@ -0,0 +1,143 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_MATCHED_FILTER_H_
+#define DCF77_INTERNAL_DCF77_MATCHED_FILTER_H_
+
+#include <stdint.h>
+#include "ISR_ATTR.h"
+
+/**
+ * Period in milliseconds in which the receiver pin is sampled by
+ * DCF77sampledRx. Must divide 100, so that a 100ms pulse spans an
+ * integral number of samples.
+ */
+#ifndef DCF77_SAMPLE_MILLIS
+#define DCF77_SAMPLE_MILLIS 10
+#endif
+
+static_assert(DCF77_SAMPLE_MILLIS > 0 && 100 % DCF77_SAMPLE_MILLIS == 0,
+    "DCF77_SAMPLE_MILLIS must divide 100");
+
+/**
+ * Soft decision decoder for a pin that is sampled at a fixed rate.
+ *
+ * The beginning of the second is tracked by a low pass filtered
+ * histogram of the low samples per sample slot of the second. The slot
+ * where a 100ms window collects most low samples is the second mark.
+ *
+ * Each second is then correlated with the templates of a 100ms and a
+ * 200ms pulse. Their difference is the sum of the samples between
+ * 100ms and 200ms, counted +1 if low and -1 if high. Its sign is the
+ * bit, its magnitude the confidence. A single glitch only flips the
+ * samples it covers, instead of shifting an edge.
+ */
+class DCF77matchedFilter {
+public:
+  static constexpr uint16_t SAMPLES_PER_SECOND = 1000 / DCF77_SAMPLE_MILLIS;
+  static constexpr uint8_t PULSE_SAMPLES = 100 / DCF77_SAMPLE_MILLIS;
+  /**
+   * Samples from the beginning of a second until it is evaluated. Leaves
+   * a margin of half a pulse width after the end of a 200ms pulse.
+   */
+  static constexpr uint16_t EVALUATION_DELAY = 5 * PULSE_SAMPLES / 2;
+
+  /** The evaluation of a second. */
+  struct Second {
+    /**
+     * Correlation with the 200ms template minus correlation with the
+     * 100ms template in range [-PULSE_SAMPLES, PULSE_SAMPLES]. Positive
+     * for bit 1.
+     */
+    int8_t mSoftBit;
+    /** The second carries a mark. False for second 59. */
+    bool mMarked;
+  };
+
+  DCF77matchedFilter();
+
+  /**
+   * Add a sample. To be called every DCF77_SAMPLE_MILLIS.
+   *
+   * @param[in] low The pin level is low, i.e. the carrier is reduced.
+   * @param[out] second The evaluation of the past second.
+   *
+   * @return true, if a second has been evaluated. Happens once per
+   *  second, EVALUATION_DELAY samples after the second mark.
+   */
+  TEXT_ISR_ATTR_2_INLINE
+  bool addSample(const bool low, Second& second) {
+    const uint16_t slot = mSlot;
+    const uint8_t score = mLowScore[slot];
+    mLowScore[slot] = score - (score >> 4) + (low ? 15 : 0);
+    const uint8_t mask = 1 << (slot & 7);
+    if (low) {
+      mHistory[slot >> 3] |= mask;
+    } else {
+      mHistory[slot >> 3] &= ~mask;
+    }
+    mSlot = slot + 1 == SAMPLES_PER_SECOND ? 0 : slot + 1;
+
+    if (mSinceEvaluation < SAMPLES_PER_SECOND) {
+      mSinceEvaluation++;
+    }
+    // A phase correction must not evaluate the same second twice.
+    if (slot != mEvaluationSlot || mSinceEvaluation < SAMPLES_PER_SECOND / 2) {
+      return false;
+    }
+    mSinceEvaluation = 0;
+    evaluate(second);
+    trackPhase();
+    return true;
+  }
+
+  /** The sample slot of the second mark. */
+  uint16_t phase() const {
+    return mPhase;
+  }
+
+private:
+  TEXT_ISR_ATTR_3
+  void evaluate(Second& second) const;
+
+  /**
+   * Move the phase to the slot with the highest low score within a
+   * pulse window. Keeps the phase if there is no better one.
+   */
+  TEXT_ISR_ATTR_3
+  void trackPhase();
+
+  /* Low pass filtered count of low samples per slot, at most 240. */
+  uint8_t mLowScore[SAMPLES_PER_SECOND];
+  /* The latest sample of every slot. */
+  uint8_t mHistory[(SAMPLES_PER_SECOND + 7) / 8];
+  uint16_t mSlot = 0;
+  uint16_t mPhase = 0;
+  uint16_t mEvaluationSlot = EVALUATION_DELAY;
+  uint16_t mSinceEvaluation = 0;
+};
+
+#endif /* DCF77_INTERNAL_DCF77_MATCHED_FILTER_H_ */
@@ -0,0 +1,168 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_PIN_H_
+#define DCF77_INTERNAL_DCF77_PIN_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "ISR_ATTR.h"
+
+/**
+ * Compile time pin access for the interrupt handlers.
+ *
+ * digitalRead() looks up the port and the bit mask of the pin in flash
+ * tables and checks for a PWM timer on every call. Since the receiver
+ * pin is a template parameter, the input register and the bit mask can
+ * be resolved at compile time instead. On the ATmega328P (Uno, Nano,
+ * Pro Mini) and the ATmega2560 (Mega) DCF77pin<PIN>::read() compiles to
+ * a single in or lds instruction plus the bit test. On all other
+ * platforms and for pins that are not in the map, it falls back to
+ * digitalRead().
+ *
+ * The PWM check of digitalRead() is skipped. The receiver pin is an
+ * input, so there is no PWM output to turn off.
+ */
+namespace DCF77pinmap {
+
+/* No direct access. */
+constexpr uint16_t NO_REGISTER = 0;
+
+#if defined(ARDUINO_ARCH_AVR) && (defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__))
+
+/* Data memory addresses of PINB, PINC and PIND. */
+constexpr uint16_t inputRegister(const int pin) {
+  return pin < 0 ? NO_REGISTER : pin < 8 ? 0x29 : pin < 14 ? 0x23 : pin < 20 ? 0x26 : NO_REGISTER;
+}
+
+constexpr uint8_t bitMask(const int pin) {
+  return static_cast<uint8_t>(1 << (pin < 8 ? pin : pin < 14 ? pin - 8 : pin - 14));
+}
+
+#elif defined(ARDUINO_ARCH_AVR) && (defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1280__))
+
+/* Data memory addresses of PINA to PINL. There is no port I. */
+constexpr uint16_t PIN_REGISTERS[] = {
+  0x20, 0x23, 0x26, 0x29, 0x2C, 0x2F, 0x32, 0x100, 0x103, 0x106, 0x109,
+};
+
+enum : uint8_t {
+  PORT_A, PORT_B, PORT_C, PORT_D, PORT_E, PORT_F, PORT_G, PORT_H, PORT_J, PORT_K, PORT_L
+};
+
+/* Port and bit of the Mega pins 0 to 69. */
+#define DCF77_PORT_BIT(port, bit) static_cast<uint8_t>(PORT_##port << 3 | (bit))
+constexpr uint8_t PORT_BITS[] = {
+  DCF77_PORT_BIT(E, 0), DCF77_PORT_BIT(E, 1), DCF77_PORT_BIT(E, 4), DCF77_PORT_BIT(E, 5),
+  DCF77_PORT_BIT(G, 5), DCF77_PORT_BIT(E, 3), DCF77_PORT_BIT(H, 3), DCF77_PORT_BIT(H, 4),
+  DCF77_PORT_BIT(H, 5), DCF77_PORT_BIT(H, 6), DCF77_PORT_BIT(B, 4), DCF77_PORT_BIT(B, 5),
+  DCF77_PORT_BIT(B, 6), DCF77_PORT_BIT(B, 7), DCF77_PORT_BIT(J, 1), DCF77_PORT_BIT(J, 0),
+  DCF77_PORT_BIT(H, 1), DCF77_PORT_BIT(H, 0), DCF77_PORT_BIT(D, 3), DCF77_PORT_BIT(D, 2),
+  DCF77_PORT_BIT(D, 1), DCF77_PORT_BIT(D, 0), DCF77_PORT_BIT(A, 0), DCF77_PORT_BIT(A, 1),
+  DCF77_PORT_BIT(A, 2), DCF77_PORT_BIT(A, 3), DCF77_PORT_BIT(A, 4), DCF77_PORT_BIT(A, 5),
+  DCF77_PORT_BIT(A, 6), DCF77_PORT_BIT(A, 7), DCF77_PORT_BIT(C, 7), DCF77_PORT_BIT(C, 6),
+  DCF77_PORT_BIT(C, 5), DCF77_PORT_BIT(C, 4), DCF77_PORT_BIT(C, 3), DCF77_PORT_BIT(C, 2),
+  DCF77_PORT_BIT(C, 1), DCF77_PORT_BIT(C, 0), DCF77_PORT_BIT(D, 7), DCF77_PORT_BIT(G, 2),
+  DCF77_PORT_BIT(G, 1), DCF77_PORT_BIT(G, 0), DCF77_PORT_BIT(L, 7), DCF77_PORT_BIT(L, 6),
+  DCF77_PORT_BIT(L, 5), DCF77_PORT_BIT(L, 4), DCF77_PORT_BIT(L, 3), DCF77_PORT_BIT(L, 2),
+  DCF77_PORT_BIT(L, 1), DCF77_PORT_BIT(L, 0), DCF77_PORT_BIT(B, 3), DCF77_PORT_BIT(B, 2),
+  DCF77_PORT_BIT(B, 1), DCF77_PORT_BIT(B, 0), DCF77_PORT_BIT(F, 0), DCF77_PORT_BIT(F, 1),
+  DCF77_PORT_BIT(F, 2), DCF77_PORT_BIT(F, 3), DCF77_PORT_BIT(F, 4), DCF77_PORT_BIT(F, 5),
+  DCF77_PORT_BIT(F, 6), DCF77_PORT_BIT(F, 7), DCF77_PORT_BIT(K, 0), DCF77_PORT_BIT(K, 1),
+  DCF77_PORT_BIT(K, 2), DCF77_PORT_BIT(K, 3), DCF77_PORT_BIT(K, 4), DCF77_PORT_BIT(K, 5),
+  DCF77_PORT_BIT(K, 6), DCF77_PORT_BIT(K, 7),
+};
+#undef DCF77_PORT_BIT
+
+constexpr int PIN_COUNT = sizeof(PORT_BITS) / sizeof(PORT_BITS[0]);
+
+constexpr uint16_t inputRegister(const int pin) {
+  return pin < 0 || pin >= PIN_COUNT ? NO_REGISTER : PIN_REGISTERS[PORT_BITS[pin] >> 3];
+}
+
+constexpr uint8_t bitMask(const int pin) {
+  return pin < 0 || pin >= PIN_COUNT ? 0 : static_cast<uint8_t>(1 << (PORT_BITS[pin] & 7));
+}
+
+#else
+
+constexpr uint16_t inputRegister(const int) {
+  return NO_REGISTER;
+}
+
+constexpr uint8_t bitMask(const int) {
+  return 0;
+}
+
+#endif
+
+} // namespace DCF77pinmap
+
+/**
+ * Direct access to the input register. The output register follows
+ * the input and the data direction register on both AVR types.
+ */
+template<int PIN, uint16_t INPUT_REGISTER = DCF77pinmap::inputRegister(PIN)> struct DCF77pin {
+  static constexpr bool DIRECT = true;
+
+  TEXT_ISR_ATTR_1_INLINE
+  static int read() {
+    return (*reinterpret_cast<volatile uint8_t*>(INPUT_REGISTER) & DCF77pinmap::bitMask(PIN))
+        ? HIGH : LOW;
+  }
+
+  /**
+   * Set an output pin. Outside of the interrupt context, the caller
+   * must disable interrupts, unless the port is in the lower I/O
+   * space, where the compiler emits a single sbi or cbi.
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  static void write(const int level) {
+    volatile uint8_t& port = *reinterpret_cast<volatile uint8_t*>(INPUT_REGISTER + 2);
+    if (level == LOW) {
+      port &= static_cast<uint8_t>(~DCF77pinmap::bitMask(PIN));
+    } else {
+      port |= DCF77pinmap::bitMask(PIN);
+    }
+  }
+};
+
+/** Fallback to digitalRead() and digitalWrite(). */
+template<int PIN> struct DCF77pin<PIN, DCF77pinmap::NO_REGISTER> {
+  static constexpr bool DIRECT = false;
+
+  TEXT_ISR_ATTR_1_INLINE
+  static int read() {
+    return digitalRead(PIN);
+  }
+
+  TEXT_ISR_ATTR_1_INLINE
+  static void write(const int level) {
+    digitalWrite(PIN, level);
+  }
+};
+
+#endif /* DCF77_INTERNAL_DCF77_PIN_H_ */
@@ -0,0 +1,159 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#include "DCF77powerSchedulerbase.h"
+#include "DCF77wallclock.h"
+
+#include <Arduino.h>
+
+namespace {
+
+/* A frame is complete at a minute mark only, so a window may take up
+ * to a minute longer than the latest one. */
+constexpr uint32_t MINUTE_MILLIS = 60000;
+/* Attach the receiver this long before a minute mark. The gap before
+ * the mark must be seen, and the clock may be off a little. */
+constexpr uint32_t LISTEN_LEAD_MILLIS = 2500;
+/* The backoff after failed windows doubles the interval at most this
+ * often. */
+constexpr uint8_t MAX_BACKOFF_STEPS = 16;
+
+} // anonymous namespace
+
+void DCF77powerSchedulerbase::start() {
+  const uint32_t now = millis();
+  mRunning = true;
+  mSynced = false;
+  mFailuresInRow = 0;
+  mPowerOnSince = now;
+  enableReceiver(true);
+  enter(POWER_WARMUP, now);
+}
+
+void DCF77powerSchedulerbase::stop() {
+  if (not mRunning) {
+    return;
+  }
+  if (mState != POWER_OFF) {
+    closeWindow(millis(), 0);
+  }
+  mRunning = false;
+}
+
+DCF77powerSchedulerbase::POWER_STATE DCF77powerSchedulerbase::poll() {
+  if (not mRunning) {
+    return mState;
+  }
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - mStateSince;
+  switch (mState) {
+  case POWER_OFF:
+    if (elapsed >= mIntervalMillis) {
+      mPowerOnSince = now;
+      enableReceiver(true);
+      enter(POWER_WARMUP, now);
+    }
+    break;
+  case POWER_WARMUP:
+    if (elapsed >= mWarmupMillis) {
+      mFrameCountSeen = mClock.frameCount();
+      attachReceiver(true);
+      enter(POWER_LISTEN, now);
+    }
+    break;
+  case POWER_LISTEN:
+    if (mClock.frameCount() != mFrameCountSeen) {
+      mLastSyncMillis = elapsed;
+      mSynced = true;
+      mSyncCount++;
+      mFailuresInRow = 0;
+      closeWindow(now, alignToMinute(syncedInterval()));
+    } else if (mSynced && elapsed >= mWindowMillis) {
+      // Retry after the minimum interval, and back off while the
+      // signal stays away.
+      mFailedCount++;
+      uint32_t interval = mMinIntervalMillis;
+      for (uint8_t i = 0; i < mFailuresInRow && interval < mMaxIntervalMillis / 2; i++) {
+        interval *= 2;
+      }
+      if (mFailuresInRow < MAX_BACKOFF_STEPS) {
+        mFailuresInRow++;
+      }
+      closeWindow(now, alignToMinute(interval < mMaxIntervalMillis ? interval : mMaxIntervalMillis));
+    }
+    break;
+  }
+  return mState;
+}
+
+uint32_t DCF77powerSchedulerbase::onTimeSeconds() const {
+  uint32_t millisOn = mOnMillis;
+  if (mRunning && mState != POWER_OFF) {
+    millisOn += millis() - mPowerOnSince;
+  }
+  return mOnSeconds + millisOn / 1000;
+}
+
+void DCF77powerSchedulerbase::closeWindow(const uint32_t now, const uint32_t interval) {
+  if (mState == POWER_LISTEN) {
+    attachReceiver(false);
+  }
+  enableReceiver(false);
+  const uint32_t millisOn = mOnMillis + (now - mPowerOnSince);
+  mOnSeconds += millisOn / 1000;
+  mOnMillis = static_cast<uint16_t>(millisOn % 1000);
+  mIntervalMillis = interval;
+  enter(POWER_OFF, now);
+}
+
+uint32_t DCF77powerSchedulerbase::syncedInterval() {
+  // Take over the new frame and its drift measurement.
+  DCF77::time_t timestamp;
+  mClock.getTimestamp(timestamp);
+  // The next window must have received a frame, before the error bound
+  // of the clock exceeds the limit. Open it earlier by the warm-up and
+  // by the time the latest sync took.
+  const uint32_t holdover = mClock.holdoverMillis(mMaxErrorMillis);
+  const uint32_t lead = mWarmupMillis + mLastSyncMillis + MINUTE_MILLIS;
+  const uint32_t interval = holdover > lead ? holdover - lead : 0;
+  return interval < mMinIntervalMillis ? mMinIntervalMillis
+      : interval > mMaxIntervalMillis ? mMaxIntervalMillis : interval;
+}
+
+uint32_t DCF77powerSchedulerbase::alignToMinute(const uint32_t interval) {
+  // A frame is delivered at the end of the first complete minute after
+  // the receiver is attached. Attaching it just before a minute mark
+  // saves up to a minute of on-time per window.
+  DCF77::time_t timestamp;
+  unsigned millisec;
+  if (not mClock.getTimestamp(timestamp, &millisec)) {
+    return interval;
+  }
+  const uint32_t millisOfMinute = static_cast<uint32_t>(timestamp % 60) * 1000 + millisec;
+  const uint32_t late = (millisOfMinute + interval + mWarmupMillis + LISTEN_LEAD_MILLIS)
+      % MINUTE_MILLIS;
+  if (interval >= mMinIntervalMillis + late) {
+    return interval - late;
+  }
+  return interval + (MINUTE_MILLIS - late);
+}
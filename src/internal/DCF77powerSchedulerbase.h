@@ -0,0 +1,170 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_POWERSCHEDULERBASE_H_
+#define DCF77_INTERNAL_DCF77_POWERSCHEDULERBASE_H_
+
+#include <stdint.h>
+
+class DCF77wallclock;
+
+/**
+ * This base class does the main work of the power scheduler. It runs
+ * the state machine of the sync windows on millis() and adapts the
+ * interval between them. The derived template class
+ * DCF77powerScheduler switches the receiver.
+ */
+class DCF77powerSchedulerbase {
+public:
+  enum POWER_STATE : uint8_t {
+    /* The receiver is powered off until the next window. */
+    POWER_OFF,
+    /* The receiver is powered, its output is not yet valid. */
+    POWER_WARMUP,
+    /* The pin interrupt is attached until a frame is received. */
+    POWER_LISTEN,
+  };
+
+  /**
+   * Power the receiver on and open a window, that stays open until a
+   * frame is received. Called by begin() of DCF77powerScheduler. Call
+   * it again to resume after stop().
+   */
+  void start();
+
+  /**
+   * Power the receiver off and stop the scheduling.
+   */
+  void stop();
+
+  /**
+   * Advance the state machine. To be called frequently from loop().
+   *
+   * @return The state after the call.
+   */
+  POWER_STATE poll();
+
+  POWER_STATE state() const {
+    return mState;
+  }
+
+  /**
+   * The time in milliseconds the receiver stays off after the latest
+   * window.
+   */
+  uint32_t intervalMillis() const {
+    return mIntervalMillis;
+  }
+
+  /**
+   * The time in milliseconds the latest successful window listened,
+   * until a frame was received.
+   */
+  uint32_t lastSyncMillis() const {
+    return mLastSyncMillis;
+  }
+
+  /**
+   * The time the receiver has been powered since start(), in seconds.
+   */
+  uint32_t onTimeSeconds() const;
+
+  /** The number of windows that received a frame. */
+  uint32_t syncCount() const {
+    return mSyncCount;
+  }
+
+  /** The number of windows that closed without frame. */
+  uint32_t failedCount() const {
+    return mFailedCount;
+  }
+
+protected:
+  /**
+   * @param[in] clock The clock that receives the frames. Its frame
+   *  count tells a successful window, its drift estimate the interval.
+   * @param[in] warmupMillis The time from power on to a valid output
+   *  of the receiver.
+   * @param[in] windowMillis The time a window listens for a frame.
+   * @param[in] maxErrorMillis The error bound of the clock, that
+   *  is to be kept by the next window.
+   * @param[in] minIntervalMillis The minimum time between two windows.
+   * @param[in] maxIntervalMillis The maximum time between two windows.
+   */
+  DCF77powerSchedulerbase(DCF77wallclock& clock, const uint32_t warmupMillis,
+      const uint32_t windowMillis, const uint32_t maxErrorMillis,
+      const uint32_t minIntervalMillis, const uint32_t maxIntervalMillis)
+    : mClock(clock), mWarmupMillis(warmupMillis), mWindowMillis(windowMillis),
+      mMaxErrorMillis(maxErrorMillis), mMinIntervalMillis(minIntervalMillis),
+      mMaxIntervalMillis(maxIntervalMillis) {
+  }
+
+private:
+  /**
+   * Switch the supply of the receiver.
+   */
+  virtual void enableReceiver(const bool on) = 0;
+
+  /**
+   * Start or stop the decoding of the receiver output.
+   */
+  virtual void attachReceiver(const bool on) = 0;
+
+  /* Close the window and power the receiver off for the interval. */
+  void closeWindow(const uint32_t now, const uint32_t interval);
+  /* The interval after a frame has been received. */
+  uint32_t syncedInterval();
+  /* Shift the interval, so that the receiver is attached just before
+     a minute mark. */
+  uint32_t alignToMinute(const uint32_t interval);
+  void enter(const POWER_STATE state, const uint32_t now) {
+    mState = state;
+    mStateSince = now;
+  }
+
+  DCF77wallclock& mClock;
+  const uint32_t mWarmupMillis;
+  const uint32_t mWindowMillis;
+  const uint32_t mMaxErrorMillis;
+  const uint32_t mMinIntervalMillis;
+  const uint32_t mMaxIntervalMillis;
+  POWER_STATE mState = POWER_OFF;
+  bool mRunning = false;
+  /* A window has received a frame. Until then it doesn't close. */
+  bool mSynced = false;
+  uint32_t mFrameCountSeen = 0;
+  uint8_t mFailuresInRow = 0;
+  uint32_t mStateSince = 0;
+  uint32_t mPowerOnSince = 0;
+  uint32_t mIntervalMillis = 0;
+  uint32_t mLastSyncMillis = 0;
+  uint32_t mSyncCount = 0;
+  uint32_t mFailedCount = 0;
+  /* The on-time of the closed windows. */
+  uint32_t mOnSeconds = 0;
+  uint16_t mOnMillis = 0;
+};
+
+#endif /* DCF77_INTERNAL_DCF77_POWERSCHEDULERBASE_H_ */
@@ -0,0 +1,180 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_QUEUE_H_
+#define DCF77_INTERNAL_DCF77_QUEUE_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "ISR_ATTR.h"
+
+#ifndef ARDUINO_ARCH_AVR
+#define HAS_STD_ATOMIC true
+#endif
+
+#if HAS_STD_ATOMIC
+#include <atomic>
+#endif
+
+/**
+ * An event counter, that is incremented by an interrupt handler and
+ * read by the main loop or a task.
+ */
+class DCF77isrCounter {
+public:
+  /** Count an event. To be called by the interrupt handler only. */
+  TEXT_ISR_ATTR_1_INLINE
+  void increment() {
+#if HAS_STD_ATOMIC
+    mCount.store(mCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#else
+    mCount = mCount + 1;
+#endif
+  }
+
+  uint32_t value() const {
+#if HAS_STD_ATOMIC
+    return mCount.load(std::memory_order_relaxed);
+#else
+    // A 32 bit value can't be read atomically on AVR.
+    noInterrupts();
+    const uint32_t result = mCount;
+    interrupts();
+    return result;
+#endif
+  }
+
+private:
+#if HAS_STD_ATOMIC
+  std::atomic<uint32_t> mCount {0};
+#else
+  volatile uint32_t mCount = 0;
+#endif
+};
+
+/**
+ * A fixed size, wait-free single producer / single consumer ring buffer.
+ * The producer is an interrupt handler, the consumer is the main loop or
+ * a task. Neither side ever blocks or disables interrupts.
+ *
+ * If the ring is full, push() drops the item and counts the overflow.
+ *
+ * @tparam T The item type.
+ * @tparam CAPACITY The number of items. Must be a power of 2 and not
+ *  larger than 128, so that the free running 8 bit indices can be read
+ *  atomically on every platform.
+ */
+template<typename T, uint8_t CAPACITY> class DCF77spscQueue {
+  static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+      "CAPACITY must be a power of 2");
+  static_assert(CAPACITY <= 128, "CAPACITY must not exceed 128");
+
+public:
+  /**
+   * Append an item. To be called by the producer only.
+   *
+   * @return false, if the queue was full and the item was dropped.
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  bool push(const T& item) {
+    const uint8_t head = loadRelaxed(mHead);
+    if (static_cast<uint8_t>(head - loadAcquire(mTail)) == CAPACITY) {
+      mOverflowCount.increment();
+      return false;
+    }
+    mItems[head & (CAPACITY - 1)] = item;
+    storeRelease(mHead, static_cast<uint8_t>(head + 1));
+    return true;
+  }
+
+  /**
+   * Remove the oldest item. To be called by the consumer only.
+   *
+   * @return false, if the queue was empty.
+   */
+  bool pop(T& item) {
+    const uint8_t tail = loadRelaxed(mTail);
+    if (tail == loadAcquire(mHead)) {
+      return false;
+    }
+    item = mItems[tail & (CAPACITY - 1)];
+    storeRelease(mTail, static_cast<uint8_t>(tail + 1));
+    return true;
+  }
+
+  /**
+   * The number of items that have been dropped, because the queue
+   * was full.
+   */
+  uint32_t overflowCount() const {
+    return mOverflowCount.value();
+  }
+
+private:
+#if HAS_STD_ATOMIC
+  template<typename V> using atomic_t = std::atomic<V>;
+
+  template<typename V> static V loadRelaxed(const atomic_t<V>& v) {
+    return v.load(std::memory_order_relaxed);
+  }
+  template<typename V> static V loadAcquire(const atomic_t<V>& v) {
+    return v.load(std::memory_order_acquire);
+  }
+  template<typename V> static void storeRelaxed(atomic_t<V>& v, V value) {
+    v.store(value, std::memory_order_relaxed);
+  }
+  template<typename V> static void storeRelease(atomic_t<V>& v, V value) {
+    v.store(value, std::memory_order_release);
+  }
+#else
+  template<typename V> using atomic_t = volatile V;
+
+  // Single core: A compiler barrier is sufficient to keep the item access
+  // on the right side of the index update.
+  template<typename V> static V loadRelaxed(const atomic_t<V>& v) {
+    return v;
+  }
+  template<typename V> static V loadAcquire(const atomic_t<V>& v) {
+    const V result = v;
+    asm volatile("" ::: "memory");
+    return result;
+  }
+  template<typename V> static void storeRelaxed(atomic_t<V>& v, V value) {
+    v = value;
+  }
+  template<typename V> static void storeRelease(atomic_t<V>& v, V value) {
+    asm volatile("" ::: "memory");
+    v = value;
+  }
+#endif
+
+  T mItems[CAPACITY];
+  atomic_t<uint8_t> mHead {0};
+  atomic_t<uint8_t> mTail {0};
+  DCF77isrCounter mOverflowCount;
+};
+
+#endif /* DCF77_INTERNAL_DCF77_QUEUE_H_ */
@@ -23,155 +23,227 @@
 */
 
 #include "DCF77rxbase.h"
+#include "DCF77frame.h"
+#include "DCF77combiner.h"
+#include "DCF77accumulator.h"
 
 #include <Arduino.h>
 
-/**
- * Number of milliseconds to elapse before we assume a "1",
- * if we receive a falling edge before - its a 0.
- */
-constexpr int DCF_SPLIT_MILLIS = 170;
-/**
- * There is no signal in second 59 - detect the beginning of
- * a new minute.
- */
-constexpr int DCF_SYNC_MILLIS = 1200;
-
-
-constexpr int DCF_SIGNAL_STATE_LOW  = 0;
-constexpr int DCF_SIGNAL_STATE_HIGH = !DCF_SIGNAL_STATE_LOW;
+namespace {
 
 /**
- * DCF time format struct
+ * Tens of a BCD digit pair, indexed by the upper nibble. The upper nibble
+ * of a valid BCD number doesn't exceed 9, but the full range is covered
+ * to produce a defined result for any received bit pattern.
  */
-struct DCF77bits {
-  uint64_t prefix:15;
-  uint64_t R			:1;
-  uint64_t A1			:1;
-  uint64_t Z1			:1; // Set to 1 when CEST is in effect
-  uint64_t Z2			:1; // Set to 1 when CET  is in effect
-  uint64_t A2			:1;
-  uint64_t S			:1;
-  uint64_t Min		:7;	// minutes
-  uint64_t P1			:1;	// parity minutes
-  uint64_t Hour		:6;	// hours
-  uint64_t P2			:1;	// parity hours
-  uint64_t Day		:6;	// day
-  uint64_t Weekday:3;	// day of week
-  uint64_t Month	:5;	// month
-  uint64_t Year		:8;	// year (last 2 digits)
-  uint64_t P3			:1;	// parity
+constexpr uint8_t BCD_TENS[16] = {
+	0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150
 };
 
-struct {
-	unsigned char parity_flag	:1;
-	unsigned char parity_min	:1;
-	unsigned char parity_hour	:1;
-	unsigned char parity_date	:1;
-} flags;
+constexpr bool bcdTensValid(unsigned i) {
+	return i == sizeof(BCD_TENS) || (BCD_TENS[i] == 10 * i && bcdTensValid(i + 1));
+}
+static_assert(bcdTensValid(0), "BCD_TENS must hold 10 times the index");
 
 /**
- * Interrupthandler for signal pin
+ * DCF77 weekday 1 (Monday) .. 7 (Sunday) to tm_wday 0 (Sunday) .. 6.
  */
-void DCF77rxbase::onPinInterrupt(int pin) {
-	// check the value again - since it takes some time to activate
-	// the interrupt routine, we get a clear signal.
-	DCF77pulse dcf77signal;
-	dcf77signal.mPulseLevel = digitalRead(pin);
-	dcf77signal.mPulseTime = millis();
+constexpr uint8_t TM_WDAY[8] = {0, 1, 2, 3, 4, 5, 6, 0};
 
-//	pushPulse(dcf77signal);
+/**
+ * Encode a number 0..99 as BCD.
+ */
+inline uint32_t bcd(const int value) {
+	const uint32_t tens = static_cast<uint32_t>(value) / 10;
+	return (tens << 4) | (value - 10 * tens);
+}
 
-	processPulse(dcf77signal);
+/**
+ * Decode a BCD field of the frame.
+ */
+template<typename FIELD> inline int bcdField(const uint64_t& dcf77frame) {
+	static_assert(FIELD::width <= 8, "BCD field must not exceed 2 digits");
+	const uint32_t bcd = FIELD::extract(dcf77frame);
+	return BCD_TENS[bcd >> 4] + (bcd & 0x0F);
 }
 
+} // anonymous namespace
+
 void DCF77rxbase::dcf77frame2time(DCF77::tm &time, const uint64_t& dcf77frame) {
-	const DCF77bits& bits = reinterpret_cast<const DCF77bits&>(dcf77frame);
+	using namespace DCF77frame;
 	time.tm_sec = 0;
-	time.tm_min = bits.Min - ((bits.Min / 16) * 6);
-	time.tm_hour = bits.Hour - ((bits.Hour / 16) * 6);
-	time.tm_wday = (bits.Weekday - ((bits.Weekday / 16) * 6)) % 7;
-	time.tm_mday = bits.Day - ((bits.Day / 16) * 6);
-	time.tm_mon = bits.Month - ((bits.Month / 16) * 6) - 1;
+	time.tm_min = bcdField<Min>(dcf77frame);
+	time.tm_hour = bcdField<Hour>(dcf77frame);
+	time.tm_wday = TM_WDAY[Weekday::extract(dcf77frame)];
+	time.tm_mday = bcdField<Day>(dcf77frame);
+	time.tm_mon = bcdField<Month>(dcf77frame) - 1;
 	time.tm_yday = -1; // unknown
-	time.tm_year = 100 + bits.Year - ((bits.Year / 16) * 6);
-	time.tm_isdst = bits.Z1;
+	time.tm_year = 100 + bcdField<Year>(dcf77frame);
+	time.tm_isdst = Z1::extract(dcf77frame);
+}
+
+uint64_t DCF77rxbase::dcf77time2frame(const DCF77::tm &time) {
+	using namespace DCF77frame;
+	const uint32_t min = bcd(time.tm_min);
+	const uint32_t hour = bcd(time.tm_hour);
+	const uint64_t date = Day::insert(bcd(time.tm_mday))
+			| Weekday::insert(time.tm_wday == 0 ? 7 : time.tm_wday)
+			| Month::insert(bcd(time.tm_mon + 1))
+			| Year::insert(bcd(time.tm_year - 100));
+	const bool cest = time.tm_isdst > 0;
+	return Z1::insert(cest) | Z2::insert(!cest) | S::insert(1)
+			| Min::insert(min) | P1::insert(parity(min))
+			| Hour::insert(hour) | P2::insert(parity(hour))
+			| date | P3::insert(parity(DateSection::extract(date)));
 }
 
 bool DCF77rxbase::concludeReceivedBits(uint64_t& dcf77frame) {
-  bool successfullUpdate = mRxBitBufPos == 59;
+  bool successfullUpdate = DCF77frame::completeMinute(mRxBitBuffer, mRxBitBufPos);
   dcf77frame = mRxBitBuffer;
+#if DCF77_INSTRUMENTATION
+  countConclusion(dcf77frame, successfullUpdate ? DCF77frame::BIT_COUNT : mRxBitBufPos);
+#endif
 
   // reset buffer
   mRxBitBufPos = 0;
   mRxBitBuffer = 0;
 
 	if (successfullUpdate) {
-		successfullUpdate = flags.parity_min == reinterpret_cast<struct DCF77bits&>(dcf77frame).P1
-				&& flags.parity_hour == reinterpret_cast<struct DCF77bits&>(dcf77frame).P2
-				&& flags.parity_date == reinterpret_cast<struct DCF77bits&>(dcf77frame).P3;
+		using namespace DCF77frame;
+		successfullUpdate = parityOk<MinSection>(dcf77frame)
+				&& parityOk<HourSection>(dcf77frame)
+				&& parityOk<DateSection>(dcf77frame);
 	}
 
 	return successfullUpdate;
 }
 
+#if DCF77_INSTRUMENTATION
+void DCF77rxbase::countConclusion(const uint64_t dcf77frame, const size_t bitCount) {
+  using namespace DCF77frame;
+  DCF77decoderStats& stats = mDecoderStats.beginWrite();
+  if (bitCount < BIT_COUNT) {
+    stats.shortFrames++;
+  } else if (bitCount > BIT_COUNT) {
+    stats.longFrames++;
+  } else {
+    const bool p1 = parityOk<MinSection>(dcf77frame);
+    const bool p2 = parityOk<HourSection>(dcf77frame);
+    const bool p3 = parityOk<DateSection>(dcf77frame);
+    stats.p1Errors += not p1;
+    stats.p2Errors += not p2;
+    stats.p3Errors += not p3;
+    stats.frames += p1 && p2 && p3;
+  }
+  mDecoderStats.endWrite();
+}
+#endif
+
 void DCF77rxbase::appendReceivedBit(const unsigned signalBit) {
-	if (mRxBitBufPos < 59) {
+	// Parity is checked once in concludeReceivedBits(). The bit of a
+	// leap second is kept, surplus bits beyond it are only counted, so
+	// that a frame with spurious pulses is rejected.
+	if (mRxBitBufPos <= DCF77frame::BIT_COUNT) {
 		mRxBitBuffer = mRxBitBuffer | static_cast<uint64_t>(signalBit) << mRxBitBufPos;
+	}
+	mRxBitBufPos++;
+}
 
-		// Update the parity bits. First: Reset when minute, hour or date starts.
-		if (mRxBitBufPos == 21 || mRxBitBufPos == 29 || mRxBitBufPos == 36) {
-			flags.parity_flag = 0;
-		}
-
-		// Save the parity when the corresponding segment ends
-		if (mRxBitBufPos == 28) {
-			flags.parity_min = flags.parity_flag;
-		};
+void DCF77rxbase::attachCombiner(DCF77combiner& combiner) {
+  mCombiner = &combiner;
+  mCombinerSlot = combiner.attach();
+}
 
-		if (mRxBitBufPos == 35) {
-			flags.parity_hour = flags.parity_flag;
-		};
+uint8_t DCF77rxbase::combinerConfidence(const uint32_t pulseTicks, const unsigned bit) const {
+  return DCF77combiner::confidence(pulseTicks / mTicksPerMilli, bit);
+}
 
-		if (mRxBitBufPos == 58) {
-			flags.parity_date = flags.parity_flag;
-		};
+bool DCF77rxbase::processMinuteSync(const uint32_t systick, uint64_t& dcf77frame) {
+  if (mCombiner != nullptr) {
+    mCombiner->onMinuteSync(mCombinerSlot, mRxBitBuffer, mSynced ? mRxBitBufPos : 0, systick);
+  }
+  if (mAccumulator != nullptr && mSynced) {
+    mAccumulator->onMinuteSync(mRxBitBuffer, mRxBitBufPos, systick, mTicksPerMilli);
+  }
+  mSynced = true;
+  return concludeReceivedBits(dcf77frame);
+}
 
-		// When we received a 1, toggle the parity flag
-		if (signalBit == 1) {
-			flags.parity_flag = flags.parity_flag ^ 1;
-		}
+void DCF77rxbase::processBit(const unsigned bit, const uint8_t confidence) {
+  if (mCombiner != nullptr && mSynced) {
+    mCombiner->vote(mCombinerSlot, mRxBitBufPos, confidence);
+  }
+#if DCF77_INSTRUMENTATION
+  mDecoderStats.beginWrite().bits++;
+  mDecoderStats.endWrite();
+#endif
+  appendReceivedBit(bit);
+}
 
-		mRxBitBufPos++;
-	}
+void DCF77rxbase::processSecondMark(const uint32_t systick) {
+  mSecondOfMark = mRxBitBufPos < DCF77frame::BIT_COUNT ? mRxBitBufPos : DCF77frame::BIT_COUNT;
+  mSystickAtMark = systick;
 }
 
-void DCF77rxbase::processPulse(const DCF77pulse &dcf77signal) {
-  if (dcf77signal.mPulseLevel == DCF_SIGNAL_STATE_LOW) {
-    if (mPreviousPulse.mPulseLevel != DCF_SIGNAL_STATE_LOW) {
-      /* falling edge */
-      if ((dcf77signal.mPulseTime - mPreviousPulse.mPulseTime) > DCF_SYNC_MILLIS) {
-        uint64_t dcf77frame;
-        if (concludeReceivedBits(dcf77frame)) {
-          onDCF77FrameReceived(dcf77frame, dcf77signal.mPulseTime);
-        }
-      }
-      mPreviousPulse = dcf77signal;
-    }
-  } else {
-    if (mPreviousPulse.mPulseLevel != DCF_SIGNAL_STATE_HIGH) {
-      /* rising edge */
-      const uint32_t difference = dcf77signal.mPulseTime - mPreviousPulse.mPulseTime;
-      const unsigned bit = difference < DCF_SPLIT_MILLIS ? 0 : 1;
-      appendReceivedBit(bit);
-      mPreviousPulse.mPulseLevel = dcf77signal.mPulseLevel;
+uint8_t DCF77rxbase::partialTime(DCF77::tm& time, uint32_t& systick) const {
+  // Consistent copy, the decoder may run in interrupt context.
+  noInterrupts();
+  const bool synced = mSynced;
+  const uint64_t bits = mRxBitBuffer;
+  const size_t bitCount = mRxBitBufPos;
+  const uint8_t second = mSecondOfMark;
+  systick = mSystickAtMark;
+  interrupts();
+
+  // A frame with surplus bits is broken.
+  if (not synced || second >= DCF77frame::BIT_COUNT || bitCount > DCF77frame::BIT_COUNT) {
+    return 0;
+  }
+  time.tm_sec = second;
+  uint8_t valid = PARTIAL_SECOND;
+
+  using namespace DCF77frame;
+  if (bitCount < HourSection::pos + HourSection::width
+      || not parityOk<MinSection>(bits) || not parityOk<HourSection>(bits)) {
+    return valid;
+  }
+  const int minute = bcdField<Min>(bits);
+  const int hour = bcdField<Hour>(bits);
+  const bool cest = Z1::extract(bits);
+  if (minute > 59 || hour > 23 || cest == Z2::extract(bits)) {
+    return valid;
+  }
+
+  if (bitCount == BIT_COUNT && parityOk<DateSection>(bits)) {
+    const int mday = bcdField<Day>(bits);
+    const int month = bcdField<Month>(bits);
+    if (mday >= 1 && mday <= 31 && month >= 1 && month <= 12) {
+      // The minute before the announced one. If the announced one is
+      // the first after a CET / CEST change, the offset changes, too.
+      const bool change = A1::extract(bits) && minute == 0;
+      const int32_t offset = change ? (cest ? 3600 : -3600) : 0;
+      const DCF77::time_t local = dcf77frame2utc(bits) + (cest ? 7200 : 3600);
+      const DCF77::time_t timestamp = local - 60 - offset + second;
+      DCF77::timestamp_to_tm(time, timestamp, change ? !cest : cest);
+      return valid | PARTIAL_TIME | PARTIAL_DATE;
     }
   }
-}
 
-void DCF77rxbase::begin(int pin, void (*intHandler)()) {
-	pinMode(pin, INPUT_PULLUP);
-	mPreviousPulse.mPulseLevel = digitalRead(pin);
-	attachInterrupt(digitalPinToInterrupt(pin), intHandler, CHANGE);
+  int minuteOfDay = hour * 60 + minute - 1;
+  bool isdst = cest;
+  if (A1::extract(bits) && minute == 0) {
+    minuteOfDay -= cest ? 60 : -60;
+    isdst = !cest;
+  }
+  minuteOfDay = (minuteOfDay + 24 * 60) % (24 * 60);
+  time.tm_min = minuteOfDay % 60;
+  time.tm_hour = minuteOfDay / 60;
+  time.tm_isdst = isdst;
+  return valid | PARTIAL_TIME;
 }
 
+void DCF77rxbase::discardReceivedBits() {
+  mRxBitBufPos = 0;
+  mRxBitBuffer = 0;
+  mSynced = false;
+}
@@ -30,21 +30,59 @@
 #include <stdint.h>
 #include "DCF77tm.h"
 #include "ISR_ATTR.h"
+#include "DCF77queue.h"
+#include "DCF77stats.h"
+#if DCF77_INSTRUMENTATION
+#include "DCF77seqlock.h"
+#endif
 
 /**
- * This base class does the main work to receive and
- * decode Dcf77 frames. The derived template class
- * DCF77rxtm provides only the PIN to be used.
+ * Number of pulses the interrupt handler can buffer in mode
+ * DECODE_IN_POLL, until poll() must be called. Two pulses are
+ * received per second. Must be a power of 2.
+ */
+#ifndef DCF77_PULSE_QUEUE_SIZE
+#define DCF77_PULSE_QUEUE_SIZE 8
+#endif
+
+class DCF77combiner;
+class DCF77accumulator;
+
+/**
+ * This base class does the main work to decode Dcf77 frames from the
+ * received bits. It is free of virtual functions. The derived classes
+ * detect the bits and the minute marks and deliver the frames: The
+ * template class DCF77rxStatic times the pulses in a pin interrupt, the
+ * class DCF77sampledRxbase samples the pin.
  */
 class DCF77rxbase {
 public:
   /**
-   * To be called by the interrupt handler.
+   * Selects the context in which the received pulses are decoded.
+   *
+   * DECODE_IN_ISR: The pin interrupt handler decodes the pulses and
+   *  calls onDCF77FrameReceived() within the interrupt context.
+   *
+   * DECODE_IN_POLL: The pin interrupt handler only time stamps the
+   *  pulses and queues them. They are decoded by poll(), which must be
+   *  called frequently from loop() or a task. onDCF77FrameReceived()
+   *  is called from within poll().
+   */
+  enum DECODE_MODE : uint8_t {DECODE_IN_ISR, DECODE_IN_POLL};
+
+  /**
+   * Flags returned by partialTime() for the fields that are valid.
    *
-   * @param[in] the pin for which the interrupt was triggered.
+   * PARTIAL_SECOND: tm_sec. Valid from the first minute mark on.
+   * PARTIAL_TIME: tm_min, tm_hour and tm_isdst. Valid as soon as the
+   *  minute and hour bits of the current minute have passed their
+   *  parity checks, i.e. after second 35.
+   * PARTIAL_DATE: All other fields. Valid after the date bits have
+   *  passed their parity check in second 58.
    */
-  TEXT_ISR_ATTR_1
-  void onPinInterrupt(int pin);
+  enum PARTIAL_VALIDITY : uint8_t {
+    PARTIAL_SECOND = 1, PARTIAL_TIME = 2, PARTIAL_DATE = 4
+  };
 
   /**
    * Convert a dcf77 frame to a time structure. Type DCF77tm
@@ -55,17 +93,175 @@ public:
    */
 	static void dcf77frame2time(DCF77::tm &time, const uint64_t& dcf77frame);
 
+  /**
+   * Convert a dcf77 frame directly to a UTC time stamp. The CET or
+   * CEST offset is taken from the frame. This is equivalent to, but
+   * much cheaper than dcf77frame2time() followed by
+   * DCF77::tm_to_timestamp() and the subtraction of the offset.
+   *
+   * @param[in] dcf77frame The dcf77 frame.
+   * @return The UTC time stamp of the minute, that the frame announces.
+   */
+  static DCF77::time_t dcf77frame2utc(const uint64_t dcf77frame);
+
+  /**
+   * Convert a time structure to a dcf77 frame. The inverse of
+   * dcf77frame2time(). Z1 and Z2 are set from tm_isdst, the start bit
+   * S and the parity bits are set. The announcement, call and weather
+   * bits are left 0.
+   *
+   * @param[in] time The local time of the minute, that the frame
+   *  announces. tm_year must be within 2000 and 2099.
+   *
+   * @return The dcf77 frame.
+   */
+  static uint64_t dcf77time2frame(const DCF77::tm &time);
+
+  /**
+   * Destination arrays for dcf77frames2fields(). Each array must hold
+   * as many elements as frames are decoded. The values have the same
+   * meaning as the corresponding DCF77::tm fields. An array that is
+   * not needed can be left nullptr.
+   */
+  struct DCF77frameFields {
+    uint8_t *tm_min = nullptr;
+    uint8_t *tm_hour = nullptr;
+    uint8_t *tm_mday = nullptr;
+    uint8_t *tm_mon = nullptr;   // [0..11]
+    uint8_t *tm_year = nullptr;  // years since 1900
+    uint8_t *tm_wday = nullptr;
+    uint8_t *tm_isdst = nullptr;
+  };
+
+  /**
+   * Convert an array of dcf77 frames to time fields in structure of
+   * arrays layout. The loops are free of branches and table look ups,
+   * so that the compiler can vectorize them.
+   *
+   * @param[out] fields The destination arrays.
+   * @param[in] dcf77frames The dcf77 frames.
+   * @param[in] count The number of frames.
+   */
+  static void dcf77frames2fields(const DCF77frameFields& fields,
+      const uint64_t* dcf77frames, size_t count);
+
+  /**
+   * Convert an array of dcf77 frames to UTC time stamps. The CET or
+   * CEST offset is taken from the frame. Like dcf77frames2fields()
+   * the conversion is written to be vectorized by the compiler.
+   *
+   * @param[out] utc The destination array for count time stamps.
+   * @param[in] dcf77frames The dcf77 frames.
+   * @param[in] count The number of frames.
+   */
+  static void dcf77frames2utc(DCF77::time_t* utc,
+      const uint64_t* dcf77frames, size_t count);
+
+  /**
+   * The time decoded from the bits of the current minute received so
+   * far. It is available before the minute is complete, which shortens
+   * the time from power up to a usable time stamp. The fields that are
+   * not flagged as valid are left unchanged.
+   *
+   * The frame announces the next minute, the current one is derived
+   * from it. The result refers to the latest second mark and should be
+   * extrapolated with the system tick.
+   *
+   * @param[out] time The partially decoded local time.
+   * @param[out] systick The system tick at the second mark of tm_sec.
+   *
+   * @return A combination of PARTIAL_VALIDITY flags. 0 if no minute
+   *  mark has been seen yet.
+   */
+  uint8_t partialTime(DCF77::tm& time, uint32_t& systick) const;
+
+  /**
+   * Forward the bit decisions of this receiver to a combiner, which
+   * votes on every bit across several receivers. See DCF77combiner.
+   * To be called before begin().
+   */
+  void attachCombiner(DCF77combiner& combiner);
+
+  /**
+   * Forward the bits of every minute to an accumulator, which predicts
+   * the frames from the minutes received before. See DCF77accumulator.
+   * To be called before begin().
+   */
+  void attachAccumulator(DCF77accumulator& accumulator) {
+    mAccumulator = &accumulator;
+  }
+
+#if DCF77_INSTRUMENTATION
+  /**
+   * A consistent snapshot of the decoder events. Must not be called
+   * from interrupt context. See DCF77_INSTRUMENTATION.
+   *
+   * @param[out] stats The counters.
+   */
+  void decoderStats(DCF77decoderStats& stats) const {
+    mDecoderStats.read(stats);
+  }
+#endif
+
 protected:
-	struct DCF77pulse {uint32_t mPulseTime = 0; int mPulseLevel = 1;};
+	/**
+	 * @param[in] ticksPerMilli The resolution of the system ticks
+	 *  passed to the process functions.
+	 */
+	explicit DCF77rxbase(const uint16_t ticksPerMilli = 1)
+	  : mTicksPerMilli(ticksPerMilli) {
+	}
 
 	/**
-	 * Establish interrupt handler for pin.
+	 * A minute mark has been detected. Conclude the bits received
+	 * since the previous one. The derived class delivers the frame.
+	 *
+	 * @param[in] systick The time stamp of the beginning of second 0.
+	 * @param[out] dcf77frame The received frame, if it is valid.
+	 *
+	 * @return true, if a valid frame has been received.
 	 */
-	void begin(int pin, void (*intHandler)());
+	TEXT_ISR_ATTR_2
+	bool processMinuteSync(const uint32_t systick, uint64_t& dcf77frame);
 
-private:
+	/**
+	 * A bit has been received for the next second of the minute.
+	 *
+	 * @param[in] bit The received bit.
+	 * @param[in] confidence The confidence of the bit decision for the
+	 *  combiner, in the range of DCF77combiner::confidence().
+	 */
+	TEXT_ISR_ATTR_2
+	void processBit(const unsigned bit, const uint8_t confidence);
+
+	/**
+	 * The mark at the beginning of the next second has been detected.
+	 *
+	 * @param[in] systick The system tick at the second mark.
+	 */
+	TEXT_ISR_ATTR_2
+	void processSecondMark(const uint32_t systick);
+
+	/**
+	 * Discard the bits of the current minute, e.g. after input was lost.
+	 */
+	void discardReceivedBits();
+
+	/**
+	 * The confidence of a bit decision for an attached combiner. 0, if
+	 * no combiner is attached.
+	 *
+	 * @param[in] pulseTicks The width of the pulse in system ticks.
+	 * @param[in] bit The bit decided for.
+	 */
 	TEXT_ISR_ATTR_2_INLINE
-	void processPulse(const DCF77pulse &dcf77signal);
+	uint8_t pulseConfidence(const uint32_t pulseTicks, const unsigned bit) const {
+		return mCombiner != nullptr ? combinerConfidence(pulseTicks, bit) : 0;
+	}
+
+private:
+	TEXT_ISR_ATTR_3
+	uint8_t combinerConfidence(const uint32_t pulseTicks, const unsigned bit) const;
 
 	/**
 	 * Append a received bit to the rx buffer.
@@ -87,20 +283,29 @@ private:
 	TEXT_ISR_ATTR_3_INLINE
 	bool concludeReceivedBits(uint64_t& dcf77frame);
 
+#if DCF77_INSTRUMENTATION
 	/**
-	 * Callback function to be overridden by the derived class to
-	 * obtain a received dcf77 frame. Note that this function
-	 * runs within the interrupt context and must be executed
-	 * quickly in order not to prevent other lower priority
-	 * interrupts to be serviced.
+	 * Count the outcome of concludeReceivedBits().
 	 */
-	TEXT_ISR_ATTR_4
-	virtual void onDCF77FrameReceived(const uint64_t dcf77frame,
-	    const uint32_t systick) = 0;
+	TEXT_ISR_ATTR_3
+	void countConclusion(const uint64_t dcf77frame, const size_t bitCount);
+#endif
 
   uint64_t mRxBitBuffer = 0;
   size_t mRxBitBufPos = 0;
-  DCF77pulse mPreviousPulse;
+  DCF77combiner* mCombiner = nullptr;
+  uint8_t mCombinerSlot = 0;
+  DCF77accumulator* mAccumulator = nullptr;
+  /* A minute sync has been seen, so mRxBitBufPos is the second of minute. */
+  bool mSynced = false;
+  /* The second of minute and the system tick of the latest second mark. */
+  uint8_t mSecondOfMark = 0;
+  uint32_t mSystickAtMark = 0;
+  /* The resolution of the system ticks. */
+  uint16_t mTicksPerMilli;
+#if DCF77_INSTRUMENTATION
+  DCF77seqlock<DCF77decoderStats> mDecoderStats;
+#endif
 };
 
 #endif /* DCF77_INTERNAL_DCF77_BASE_H_ */
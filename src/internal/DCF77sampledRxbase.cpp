@@ -0,0 +1,89 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77sampledRxbase.h"
+#include "DCF77combiner.h"
+
+#include <Arduino.h>
+
+void DCF77sampledRxbase::onSampleTick(int pinLevel) {
+  DCF77second second;
+  if (not mFilter.addSample(pinLevel == LOW, second.mSecond)) {
+    return;
+  }
+  // The second began EVALUATION_DELAY samples ago.
+  second.mSystick = millis()
+      - static_cast<uint32_t>(DCF77matchedFilter::EVALUATION_DELAY) * DCF77_SAMPLE_MILLIS;
+
+  if (mSampleDecodeMode == DECODE_IN_POLL) {
+    mSecondQueue.push(second);
+  } else {
+    processSecond(second);
+  }
+}
+
+size_t DCF77sampledRxbase::poll() {
+  // A lost second corrupts the frame that is currently received.
+  const uint32_t secondOverflows = mSecondQueue.overflowCount();
+  if (secondOverflows != mSecondOverflowsSeen) {
+    mSecondOverflowsSeen = secondOverflows;
+    mMinuteMarkPending = false;
+    discardReceivedBits();
+  }
+
+  size_t count = 0;
+  DCF77second second;
+  while (mSecondQueue.pop(second)) {
+    processSecond(second);
+    count++;
+  }
+  return count;
+}
+
+void DCF77sampledRxbase::processSecond(const DCF77second& second) {
+  const int8_t softBit = second.mSecond.mSoftBit;
+  mSoftBit = softBit;
+  if (not second.mSecond.mMarked) {
+    mMinuteMarkPending = true;
+    return;
+  }
+  if (mMinuteMarkPending) {
+    mMinuteMarkPending = false;
+    uint64_t dcf77frame;
+    if (processMinuteSync(second.mSystick, dcf77frame)) {
+      onDCF77FrameReceived(dcf77frame, second.mSystick);
+    }
+  }
+  processSecondMark(second.mSystick);
+
+  const uint8_t magnitude = softBit < 0 ? -softBit : softBit;
+  const uint8_t confidence = magnitude * DCF77combiner::CONFIDENCE_RANGE_MILLIS
+      / DCF77matchedFilter::PULSE_SAMPLES;
+  processBit(softBit > 0 ? 1 : 0, confidence);
+}
+
+void DCF77sampledRxbase::begin(int pin, DECODE_MODE mode) {
+  mSampleDecodeMode = mode;
+  pinMode(pin, INPUT_PULLUP);
+}
@@ -0,0 +1,111 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_SAMPLED_RXBASE_H_
+#define DCF77_INTERNAL_DCF77_SAMPLED_RXBASE_H_
+
+#include <stdint.h>
+#include "DCF77rxbase.h"
+#include "DCF77matchedFilter.h"
+
+/**
+ * This base class receives dcf77 frames from a pin, that is sampled
+ * by a timer instead of raising pin interrupts. The samples are decoded
+ * by a DCF77matchedFilter. The derived template class DCF77sampledRx
+ * provides only the PIN to be used.
+ */
+class DCF77sampledRxbase : public DCF77rxbase {
+public:
+  /**
+   * To be called by the timer interrupt handler every
+   * DCF77_SAMPLE_MILLIS milliseconds.
+   *
+   * @param[in] pinLevel The sampled level of the receiver pin.
+   */
+  TEXT_ISR_ATTR_1
+  void onSampleTick(int pinLevel);
+
+  /**
+   * Decode the seconds that the timer interrupt handler has queued in
+   * mode DECODE_IN_POLL. To be called frequently from loop() or a task,
+   * at least once within DCF77_PULSE_QUEUE_SIZE / 2 seconds.
+   *
+   * @return The number of decoded seconds.
+   */
+  size_t poll();
+
+  /**
+   * The number of seconds that were lost in mode DECODE_IN_POLL,
+   * because poll() wasn't called in time.
+   */
+  uint32_t secondOverflowCount() const {
+    return mSecondQueue.overflowCount();
+  }
+
+  /**
+   * The soft decision of the latest second. See
+   * DCF77matchedFilter::Second::mSoftBit.
+   */
+  int8_t softBit() const {
+    return mSoftBit;
+  }
+
+protected:
+  /**
+   * Configure pin as input. The caller must arrange for onSampleTick()
+   * to be called every DCF77_SAMPLE_MILLIS milliseconds.
+   */
+  void begin(int pin, DECODE_MODE mode);
+
+private:
+  struct DCF77second {
+    uint32_t mSystick;
+    DCF77matchedFilter::Second mSecond;
+  };
+
+  TEXT_ISR_ATTR_2_INLINE
+  void processSecond(const DCF77second& second);
+
+  /**
+   * Callback function to be overridden by the derived class to
+   * obtain a received dcf77 frame. It runs in the context of
+   * onSampleTick() in mode DECODE_IN_ISR and in the context of poll()
+   * in mode DECODE_IN_POLL.
+   */
+  TEXT_ISR_ATTR_4
+  virtual void onDCF77FrameReceived(const uint64_t dcf77frame,
+      const uint32_t systick) = 0;
+
+  DCF77matchedFilter mFilter;
+  DECODE_MODE mSampleDecodeMode = DECODE_IN_ISR;
+  /* The previous second carried no mark, the next one starts a minute. */
+  bool mMinuteMarkPending = false;
+  volatile int8_t mSoftBit = 0;
+  uint32_t mSecondOverflowsSeen = 0;
+  DCF77spscQueue<DCF77second, DCF77_PULSE_QUEUE_SIZE / 2> mSecondQueue;
+};
+
+#endif /* DCF77_INTERNAL_DCF77_SAMPLED_RXBASE_H_ */
@@ -0,0 +1,183 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77schedulerbase.h"
+#include "DCF77wallclock.h"
+
+DCF77schedulerbase::EVENT_ID DCF77schedulerbase::daily(const uint8_t hour,
+    const uint8_t minute, const uint8_t second) {
+  const uint32_t secondOfDay = (hour * 60UL + minute) * 60 + second;
+  if (secondOfDay >= SECONDS_PER_DAY) {
+    return NO_EVENT;
+  }
+  const EVENT_ID id = add(secondOfDay, SECONDS_PER_DAY, PENDING);
+  if (id != NO_EVENT && mHasTime) {
+    anchor(id, mNow);
+  }
+  return id;
+}
+
+bool DCF77schedulerbase::cancel(const EVENT_ID id) {
+  if (id >= mCapacity || mEvents[id].mState == FREE) {
+    return false;
+  }
+  if (mEvents[id].mState == QUEUED) {
+    remove(mEvents[id].mHeapIndex);
+  } else {
+    mPending--;
+  }
+  mEvents[id].mState = FREE;
+  return true;
+}
+
+size_t DCF77schedulerbase::run(const DCF77::time_t now) {
+  mNow = now;
+  if (not mHasTime) {
+    mHasTime = true;
+    for (EVENT_ID id = 0; mPending != 0 && id < mCapacity; id++) {
+      if (mEvents[id].mState == PENDING) {
+        anchor(id, now);
+      }
+    }
+  }
+
+  size_t fired = 0;
+  while (mQueued != 0 && mEvents[mHeap[0]].mDue <= now) {
+    const EVENT_ID id = mHeap[0];
+    Event& event = mEvents[id];
+    const DCF77::time_t due = event.mDue;
+    if (event.mPeriod != 0) {
+      // Skip the occurrences, that a jump of the time has passed over.
+      event.mDue += event.mPeriod;
+      if (event.mDue <= now) {
+        event.mDue += ((now - event.mDue) / event.mPeriod + 1) * event.mPeriod;
+      }
+      siftDown(0);
+    } else {
+      remove(0);
+      event.mState = FREE;
+    }
+    // The callback may change the heap, it is re-read above.
+    onScheduledEvent(id, due);
+    fired++;
+  }
+  return fired;
+}
+
+size_t DCF77schedulerbase::poll(DCF77wallclock& clock) {
+  DCF77::time_t now;
+  if (not clock.getTimestamp(now)) {
+    return 0;
+  }
+  return run(now);
+}
+
+bool DCF77schedulerbase::nextDue(DCF77::time_t& due) const {
+  if (mQueued == 0) {
+    return false;
+  }
+  due = mEvents[mHeap[0]].mDue;
+  return true;
+}
+
+DCF77schedulerbase::EVENT_ID DCF77schedulerbase::add(const DCF77::time_t due,
+    const uint32_t period, const STATE state) {
+  for (EVENT_ID id = 0; id < mCapacity; id++) {
+    Event& event = mEvents[id];
+    if (event.mState == FREE) {
+      event.mDue = due;
+      event.mPeriod = period;
+      event.mState = state;
+      if (state == QUEUED) {
+        push(id);
+      } else {
+        mPending++;
+      }
+      return id;
+    }
+  }
+  return NO_EVENT;
+}
+
+void DCF77schedulerbase::anchor(const EVENT_ID id, const DCF77::time_t now) {
+  Event& event = mEvents[id];
+  // The next occurrence of the second of day, now included.
+  const DCF77::time_t midnight = now - now % SECONDS_PER_DAY;
+  event.mDue += midnight;
+  if (event.mDue < now) {
+    event.mDue += SECONDS_PER_DAY;
+  }
+  event.mState = QUEUED;
+  mPending--;
+  push(id);
+}
+
+void DCF77schedulerbase::push(const EVENT_ID id) {
+  place(mQueued, id);
+  siftUp(mQueued++);
+}
+
+void DCF77schedulerbase::remove(const uint16_t heapIndex) {
+  const EVENT_ID last = mHeap[--mQueued];
+  if (heapIndex == mQueued) {
+    return;
+  }
+  place(heapIndex, last);
+  siftUp(heapIndex);
+  siftDown(mEvents[last].mHeapIndex);
+}
+
+void DCF77schedulerbase::siftUp(uint16_t heapIndex) {
+  const EVENT_ID id = mHeap[heapIndex];
+  const DCF77::time_t due = mEvents[id].mDue;
+  while (heapIndex != 0) {
+    const uint16_t parent = (heapIndex - 1) / 2;
+    if (mEvents[mHeap[parent]].mDue <= due) {
+      break;
+    }
+    place(heapIndex, mHeap[parent]);
+    heapIndex = parent;
+  }
+  place(heapIndex, id);
+}
+
+void DCF77schedulerbase::siftDown(uint16_t heapIndex) {
+  const EVENT_ID id = mHeap[heapIndex];
+  const DCF77::time_t due = mEvents[id].mDue;
+  for (;;) {
+    uint16_t child = 2 * heapIndex + 1;
+    if (child >= mQueued) {
+      break;
+    }
+    if (child + 1 < mQueued && mEvents[mHeap[child + 1]].mDue < mEvents[mHeap[child]].mDue) {
+      child++;
+    }
+    if (due <= mEvents[mHeap[child]].mDue) {
+      break;
+    }
+    place(heapIndex, mHeap[child]);
+    heapIndex = child;
+  }
+  place(heapIndex, id);
+}
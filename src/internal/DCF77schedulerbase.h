@@ -0,0 +1,165 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_SCHEDULERBASE_H_
+#define DCF77_INTERNAL_DCF77_SCHEDULERBASE_H_
+
+#include <stdint.h>
+#include "DCF77tm.h"
+
+class DCF77wallclock;
+
+/**
+ * This base class does the main work of the event scheduler. The
+ * pending events are kept in a binary min-heap, ordered by their due
+ * time as local time stamp. The derived template class DCF77scheduler
+ * provides the storage for the events.
+ */
+class DCF77schedulerbase {
+public:
+  typedef uint16_t EVENT_ID;
+  static constexpr EVENT_ID NO_EVENT = 0xFFFF;
+  static constexpr uint32_t SECONDS_PER_DAY = 86400;
+
+  /**
+   * Schedule an event once.
+   *
+   * @param[in] localTime The local time stamp when the event is due.
+   * @return The event id or NO_EVENT, if there is no free slot.
+   */
+  EVENT_ID at(const DCF77::time_t localTime) {
+    return add(localTime, 0, QUEUED);
+  }
+
+  /**
+   * Schedule a recurring event.
+   *
+   * @param[in] first The local time stamp when the event is due first.
+   * @param[in] periodSeconds The period in seconds of local time.
+   * @return The event id or NO_EVENT, if there is no free slot.
+   */
+  EVENT_ID every(const DCF77::time_t first, const uint32_t periodSeconds) {
+    return add(first, periodSeconds, QUEUED);
+  }
+
+  /**
+   * Schedule an event every day at the given local time. It can be
+   * scheduled before the time is known. It is due first on the next
+   * occurrence after the time has become known.
+   *
+   * @return The event id or NO_EVENT, if there is no free slot.
+   */
+  EVENT_ID daily(const uint8_t hour, const uint8_t minute, const uint8_t second = 0);
+
+  /**
+   * Remove an event.
+   *
+   * @return false, if id isn't a scheduled event.
+   */
+  bool cancel(const EVENT_ID id);
+
+  /**
+   * Fire all events, that are due at the local time now. A recurring
+   * event, that missed several occurrences due to a forward jump of
+   * the time, fires only once and is rescheduled to its next
+   * occurrence after now. To be called at least once per second.
+   *
+   * @param[in] now The local time stamp.
+   * @return The number of fired events.
+   */
+  size_t run(const DCF77::time_t now);
+
+  /**
+   * run() with the current time of clock. Nothing happens as long as
+   * clock doesn't know the time.
+   *
+   * @return The number of fired events.
+   */
+  size_t poll(DCF77wallclock& clock);
+
+  /**
+   * The due time of the next event.
+   *
+   * @return false, if no event is queued.
+   */
+  bool nextDue(DCF77::time_t& due) const;
+
+  /** The number of scheduled events. */
+  uint16_t size() const {
+    return mQueued + mPending;
+  }
+
+protected:
+  enum STATE : uint8_t {FREE, PENDING, QUEUED};
+
+  struct Event {
+    /* The local due time or, while PENDING, the second of day. */
+    DCF77::time_t mDue;
+    /* Recurrence in seconds, 0 for once. */
+    uint32_t mPeriod;
+    uint16_t mHeapIndex;
+    STATE mState;
+  };
+
+  DCF77schedulerbase(Event* events, uint16_t* heap, const uint16_t capacity)
+    : mEvents(events), mHeap(heap), mCapacity(capacity) {
+    for (uint16_t i = 0; i < capacity; i++) {
+      events[i].mState = FREE;
+    }
+  }
+
+private:
+  /**
+   * Callback function to be overridden by the derived class. It runs
+   * in the context of run(). It may schedule and cancel events.
+   *
+   * @param[in] id The event id.
+   * @param[in] due The local time stamp, when the event was due.
+   */
+  virtual void onScheduledEvent(const EVENT_ID id, const DCF77::time_t due) = 0;
+
+  EVENT_ID add(const DCF77::time_t due, const uint32_t period, const STATE state);
+  /* Move a PENDING daily event into the heap. */
+  void anchor(const EVENT_ID id, const DCF77::time_t now);
+  void push(const EVENT_ID id);
+  void remove(const uint16_t heapIndex);
+  void siftUp(uint16_t heapIndex);
+  void siftDown(uint16_t heapIndex);
+  void place(const uint16_t heapIndex, const EVENT_ID id) {
+    mHeap[heapIndex] = id;
+    mEvents[id].mHeapIndex = heapIndex;
+  }
+
+  Event* const mEvents;
+  uint16_t* const mHeap;
+  const uint16_t mCapacity;
+  uint16_t mQueued = 0;
+  uint16_t mPending = 0;
+  bool mHasTime = false;
+  DCF77::time_t mNow = 0;
+};
+
+#endif /* DCF77_INTERNAL_DCF77_SCHEDULERBASE_H_ */
@@ -0,0 +1,144 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_SEQLOCK_H_
+#define DCF77_INTERNAL_DCF77_SEQLOCK_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "ISR_ATTR.h"
+
+#ifndef ARDUINO_ARCH_AVR
+#define HAS_STD_ATOMIC true
+#endif
+
+#if HAS_STD_ATOMIC
+#include <atomic>
+#endif
+
+/**
+ * A sequence lock. It publishes a value, that a single writer updates,
+ * e.g. an interrupt handler, to readers in other contexts. The writer
+ * never waits. A reader copies the value and retries, if the writer
+ * has modified it in the meantime. Neither side disables interrupts.
+ *
+ * The reader must not interrupt the writer. It would spin forever in
+ * read(), if it is called from an interrupt handler while the writer
+ * runs in the main loop.
+ *
+ * The sequence is a single byte on AVR, which is read atomically. A
+ * reader, that is preempted for 128 writes, could take a torn copy
+ * for consistent. This can't happen with an interrupt handler as
+ * writer, since the reader only runs in between. With threads or a
+ * second core, the sequence has 32 bits.
+ *
+ * @tparam T The published value. It must be trivially copyable.
+ */
+template<typename T> class DCF77seqlock {
+public:
+  /**
+   * Begin to modify the value. To be called by the writer only.
+   *
+   * @return The value to be modified until endWrite().
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  T& beginWrite() {
+#if HAS_STD_ATOMIC
+    mSequence.store(mSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+#else
+    mSequence = mSequence + 1;
+    asm volatile("" ::: "memory");
+#endif
+    return mValue;
+  }
+
+  /**
+   * Publish the modified value. To be called by the writer only.
+   */
+  TEXT_ISR_ATTR_1_INLINE
+  void endWrite() {
+#if HAS_STD_ATOMIC
+    mSequence.store(mSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+#else
+    asm volatile("" ::: "memory");
+    mSequence = mSequence + 1;
+#endif
+  }
+
+  /**
+   * Copy a consistent snapshot of the value.
+   *
+   * @param[out] value The copy.
+   */
+  void read(T& value) const {
+    for (;;) {
+      const SEQUENCE before = loadAcquire();
+      if (before & 1) {
+        continue;
+      }
+      memcpy(&value, &mValue, sizeof(T));
+#if HAS_STD_ATOMIC
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (mSequence.load(std::memory_order_relaxed) == before) {
+        return;
+      }
+#else
+      asm volatile("" ::: "memory");
+      if (mSequence == before) {
+        return;
+      }
+#endif
+    }
+  }
+
+private:
+#if HAS_STD_ATOMIC
+  typedef uint32_t SEQUENCE;
+#else
+  typedef uint8_t SEQUENCE;
+#endif
+
+  SEQUENCE loadAcquire() const {
+#if HAS_STD_ATOMIC
+    return mSequence.load(std::memory_order_acquire);
+#else
+    const SEQUENCE result = mSequence;
+    asm volatile("" ::: "memory");
+    return result;
+#endif
+  }
+
+  /* Odd, while the writer modifies the value. */
+#if HAS_STD_ATOMIC
+  std::atomic<SEQUENCE> mSequence {0};
+#else
+  volatile SEQUENCE mSequence = 0;
+#endif
+  T mValue = T();
+};
+
+#endif /* DCF77_INTERNAL_DCF77_SEQLOCK_H_ */
@@ -0,0 +1,100 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_STATS_H_
+#define DCF77_INTERNAL_DCF77_STATS_H_
+
+#include <stdint.h>
+
+/**
+ * Set to 1 to count the events of the receivers and to record the
+ * execution time of the pin interrupt handler. See DCF77rxStats.
+ * When 0, the instrumentation costs neither code nor memory. The
+ * setting must be the same for all translation units, e.g. a global
+ * build flag.
+ */
+#ifndef DCF77_INSTRUMENTATION
+#define DCF77_INSTRUMENTATION 0
+#endif
+
+/**
+ * Number of bins of the histogram of the interrupt handler execution
+ * times.
+ */
+#ifndef DCF77_ISR_HISTOGRAM_BINS
+#define DCF77_ISR_HISTOGRAM_BINS 12
+#endif
+
+/**
+ * The clock that times the interrupt handler. It must count up with
+ * wraparound at 2^32.
+ */
+#ifndef DCF77_ISR_CLOCK
+#define DCF77_ISR_CLOCK() micros()
+#endif
+
+/**
+ * Events of the decoder, that turns bits into frames.
+ */
+struct DCF77decoderStats {
+  /* Bits decided from a pulse or a sampled second. */
+  uint32_t bits;
+  /* Minutes concluded with a valid frame. */
+  uint32_t frames;
+  /* Minutes concluded with less or more than 59 bits. */
+  uint32_t shortFrames;
+  uint32_t longFrames;
+  /* Minutes with 59 bits, whose minute, hour or date parity failed. */
+  uint32_t p1Errors;
+  uint32_t p2Errors;
+  uint32_t p3Errors;
+};
+
+/**
+ * Events of the pin interrupt handler.
+ */
+struct DCF77isrStats {
+  /* Calls of the pin interrupt handler. */
+  uint32_t edges;
+  /*
+   * Execution times of the handler in ticks of DCF77_ISR_CLOCK. Bin 0
+   * counts 0 ticks, bin i counts 2^(i-1) to 2^i - 1 ticks. The last
+   * bin counts all longer ones.
+   */
+  uint32_t isrTicks[DCF77_ISR_HISTOGRAM_BINS];
+};
+
+/**
+ * A consistent snapshot of the receiver instrumentation. The glitch
+ * filter and the storm protection have their own counters, that are
+ * available without instrumentation.
+ */
+struct DCF77rxStats {
+  DCF77decoderStats decoder;
+  DCF77isrStats isr;
+};
+
+#endif /* DCF77_INTERNAL_DCF77_STATS_H_ */
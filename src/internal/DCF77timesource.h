@@ -0,0 +1,87 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef DCF77_INTERNAL_DCF77_TIMESOURCE_H_
+#define DCF77_INTERNAL_DCF77_TIMESOURCE_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "ISR_ATTR.h"
+
+/**
+ * Time sources for the edge time stamps of DCF77rx, selected by its
+ * template parameter TIMESOURCE. A time source provides
+ *
+ * - TICKS_PER_MILLI: The resolution. The pulse width thresholds are
+ *   scaled by it.
+ * - now(): The time stamp of the edge, called within the pin interrupt
+ *   handler. It must count up with wraparound at 2^32 ticks.
+ * - toMillis(): Map a recent time stamp to the time base of millis().
+ *
+ * The systick passed to onDCF77FrameReceived() is in ticks of the time
+ * source. It is accurate to one tick, as long as the interrupt latency
+ * is below one tick or now() returns a hardware captured value.
+ *
+ * Input capture: On AVR timer 1 can latch the counter at the edge on
+ * the ICP1 pin (pin 8 of the Uno). A time source whose now() returns
+ * ICR1, extended to 32 bits with an overflow counter, removes the
+ * interrupt latency from the time stamps. The capture edge must be
+ * toggled in the interrupt handler, since the timer latches only one
+ * edge direction.
+ */
+
+/** millis() with 1ms resolution. The default. */
+struct DCF77millis {
+  static constexpr uint16_t TICKS_PER_MILLI = 1;
+
+  TEXT_ISR_ATTR_1_INLINE
+  static uint32_t now() {
+    return millis();
+  }
+
+  static uint32_t toMillis(const uint32_t ticks) {
+    return ticks;
+  }
+};
+
+/**
+ * micros() with 1us resolution, 4us on 16MHz AVR. The time stamps wrap
+ * around every 71 minutes.
+ */
+struct DCF77micros {
+  static constexpr uint16_t TICKS_PER_MILLI = 1000;
+
+  TEXT_ISR_ATTR_1_INLINE
+  static uint32_t now() {
+    return micros();
+  }
+
+  static uint32_t toMillis(const uint32_t ticks) {
+    return millis() - (micros() - ticks) / TICKS_PER_MILLI;
+  }
+};
+
+#endif /* DCF77_INTERNAL_DCF77_TIMESOURCE_H_ */
@@ -22,8 +22,21 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
 */
 
-#include <print.h>
+#include <string.h>
+#include <Print.h>
 #include "DCF77tm.h"
+#include "DCF77calendar.h"
+
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/pgmspace.h>
+#define HAS_PROGMEM true
+#endif
+
+#if HAS_PROGMEM
+#define DCF77_TABLE_ATTR PROGMEM
+#else
+#define DCF77_TABLE_ATTR
+#endif
 
 #define DEBUG_TIMESTAMP_TO_TM false
 
@@ -95,7 +108,7 @@ inline int leapYearsSince1970 (const int year) {
  * Calculate the expired days since 1st of January.
  */
 inline int yday(const DCF77::tm& tm) {
-  const int leapYear = isLeapYear(tm.tm_yday + DCF77::TM_YEAR_BASE);
+  const int leapYear = isLeapYear(tm.tm_year + DCF77::TM_YEAR_BASE);
   const int month = tm.tm_mon;
   const int yday_ = month_yday[leapYear][month];
   const uint8_t day = tm.tm_mday;
@@ -104,52 +117,105 @@ inline int yday(const DCF77::tm& tm) {
 
 } // anonymous namespace
 
-#if HAS_STD_CTIME
+namespace {
 
-namespace DCF77 {
+/*
+ * The tables of format_tm(). Each field is copied from a table, there
+ * is no division and no call of Print per field.
+ */
+constexpr char TWO_DIGITS[] DCF77_TABLE_ATTR =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+constexpr char WEEKDAYS[] DCF77_TABLE_ATTR = "SunMonTueWedThuFriSat???";
+constexpr char MONTHS[] DCF77_TABLE_ATTR = "JanFebMarAprMayJunJulAugSepOctNovDec???";
+
+inline void copyFromTable(char* dst, const char* table, const uint8_t count) {
+#if HAS_PROGMEM
+  memcpy_P(dst, table, count);
+#else
+  memcpy(dst, table, count);
+#endif
+}
 
-size_t print_tm(print_t& p, const DCF77::tm& time) {
-  char buffer[26];
-  asctime_r(&time, buffer);
-  buffer[24] = '\0'; // remove /n
-  return p.print(buffer);
+/* Two digits of a value 0..99. Other values are rendered as "??". */
+inline char* putTwoDigits(char* dst, const int value) {
+  if (static_cast<unsigned>(value) < 100) {
+    copyFromTable(dst, &TWO_DIGITS[2 * value], 2);
+  } else {
+    dst[0] = dst[1] = '?';
+  }
+  return dst + 2;
 }
 
+/* A name of 3 characters. An index beyond count yields "???". */
+inline char* putName(char* dst, const char* table, const int index, const unsigned count) {
+  const unsigned i = static_cast<unsigned>(index) < count ? index : count;
+  copyFromTable(dst, &table[3 * i], 3);
+  return dst + 3;
 }
 
-size_t PrintableDCF77tm::printTo(print_t& p) const {
-  return DCF77::print_tm(p, *this);
+inline char* putYear(char* dst, const int year) {
+  if (static_cast<unsigned>(year) < 10000) {
+    dst = putTwoDigits(dst, year / 100);
+    return putTwoDigits(dst, year % 100);
+  }
+  dst = putTwoDigits(dst, -1);
+  return putTwoDigits(dst, -1);
 }
 
-#else
+inline char* putTime(char* dst, const DCF77::tm& time) {
+  dst = putTwoDigits(dst, time.tm_hour);
+  *dst++ = ':';
+  dst = putTwoDigits(dst, time.tm_min);
+  *dst++ = ':';
+  return putTwoDigits(dst, time.tm_sec);
+}
 
-static const char* MO[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-static const char* WD[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+} // anonymous namespace
 
 namespace DCF77 {
 
-size_t print_tm(print_t& p, const DCF77::tm& time) {
-  size_t n = 0;
-
-  n+= p.print(WD[time.tm_wday]); // day of week
-  n+= p.print(" ");
-  n+= p.print(MO[time.tm_mon]);  // month
-  n+= p.print(" ");
-  n+= p.print(time.tm_mday);     // day of month
-
-  n+= p.print(" ");
-  if(time.tm_hour < 10) {n+= p.print('0');}
-  n+= p.print(time.tm_hour); // hour
-  n+= p.print(":");
-  if(time.tm_min < 10) {n+= p.print('0');}
-  n+= p.print(time.tm_min);  // minute
-  n+= p.print(":");
-  if(time.tm_sec < 10) {n+= p.print('0');}
-  n+= p.print(time.tm_sec);  // second
+size_t format_tm(char (&buffer)[TM_FORMAT_SIZE], const DCF77::tm& time, TM_FORMAT format) {
+  char* dst = buffer;
+  if (format == ISO8601) {
+    dst = putYear(dst, time.tm_year + TM_YEAR_BASE);
+    *dst++ = '-';
+    dst = putTwoDigits(dst, time.tm_mon + 1);
+    *dst++ = '-';
+    dst = putTwoDigits(dst, time.tm_mday);
+    *dst++ = 'T';
+    dst = putTime(dst, time);
+  } else {
+    dst = putName(dst, WEEKDAYS, time.tm_wday, 7);
+    *dst++ = ' ';
+    dst = putName(dst, MONTHS, time.tm_mon, 12);
+    *dst++ = ' ';
+    // The day of month is padded with a space like in asctime().
+    dst = putTwoDigits(dst, time.tm_mday);
+    if (dst[-2] == '0') {
+      dst[-2] = ' ';
+    }
+    *dst++ = ' ';
+    dst = putTime(dst, time);
+    *dst++ = ' ';
+    dst = putYear(dst, time.tm_year + TM_YEAR_BASE);
+  }
+  *dst = '\0';
+  return dst - buffer;
+}
 
-  n+= p.print(" ");
-  n+= p.print(time.tm_year + 1900); // year
-  return n;
+size_t print_tm(print_t& p, const DCF77::tm& time, TM_FORMAT format) {
+  char buffer[TM_FORMAT_SIZE];
+  const size_t length = format_tm(buffer, time, format);
+  return p.write(reinterpret_cast<const uint8_t*>(buffer), length);
 }
 
 } // namespace DCF77
@@ -158,11 +224,14 @@ size_t PrintableDCF77tm::printTo(print_t& p) const {
   return DCF77::print_tm(p, *this);
 }
 
-#endif
-
-namespace DCF77 {
+namespace {
 
-DCF77::time_t tm_to_timestamp(const DCF77::tm& tm) {
+#if HAS_STD_CTIME
+/**
+ * Conversions for time stamps outside of the range of the calendar
+ * kernels. Only needed, where time_t is signed or has 64 bits.
+ */
+DCF77::time_t tm_to_timestamp_generic(const DCF77::tm& tm) {
   using time_t = DCF77::time_t;
   const bool leapYear = isLeapYear(tm.tm_year + DCF77::TM_YEAR_BASE);
   const time_t leapYearsBeforeThisYear = leapYearsSince1970(tm.tm_year + DCF77::TM_YEAR_BASE) - leapYear;
@@ -171,7 +240,7 @@ DCF77::time_t tm_to_timestamp(const DCF77::tm& tm) {
   return result;
 }
 
-void timestamp_to_tm(DCF77::tm& tm, const DCF77::time_t timestamp, const int isdst)
+void timestamp_to_tm_generic(DCF77::tm& tm, const DCF77::time_t timestamp, const int isdst)
 {
   PRINT_VARIABLE(timestamp);
   long days = timestamp / SECSPERDAY + EPOCH_ADJUSTMENT_DAYS;
@@ -219,8 +288,52 @@ void timestamp_to_tm(DCF77::tm& tm, const DCF77::time_t timestamp, const int isd
   PRINT_VARIABLE(tm_mon);
   tm.tm_year = ADJUSTED_EPOCH_YEAR - DCF77::TM_YEAR_BASE + erayear + era * YEARS_PER_ERA + (month <= 1);
   PRINT_VARIABLE(tm_year);
+  tm.tm_yday = yearday >= 306 ? yearday - 306 : yearday + 59 + isLeapYear(tm.tm_year + DCF77::TM_YEAR_BASE);
+  PRINT_VARIABLE(tm_yday);
   tm.tm_isdst = isdst;
   PRINT_VARIABLE(tm_isdst);
 }
+#endif
+
+} // anonymous namespace
+
+namespace DCF77 {
+
+DCF77::time_t tm_to_timestamp(const DCF77::tm& tm) {
+  const int year = tm.tm_year + DCF77::TM_YEAR_BASE;
+#if HAS_STD_CTIME
+  // The range of DCF77calendar::days_from_civil().
+  if (year < 1970 || year > 2199) {
+    return tm_to_timestamp_generic(tm);
+  }
+#endif
+  const uint32_t days = DCF77calendar::days_from_civil(year, tm.tm_mon + 1, tm.tm_mday);
+  return static_cast<DCF77::time_t>(days) * SECSPERDAY + static_cast<int32_t>(tm.tm_hour) * SECSPERHOUR
+      + static_cast<int32_t>(tm.tm_min) * SECSPERMIN + tm.tm_sec;
+}
+
+void timestamp_to_tm(DCF77::tm& tm, const DCF77::time_t timestamp, const int isdst) {
+#if HAS_STD_CTIME
+  if (static_cast<uint64_t>(timestamp) > UINT32_MAX) {
+    timestamp_to_tm_generic(tm, timestamp, isdst);
+    return;
+  }
+#endif
+  uint32_t secondOfDay;
+  const uint32_t days = DCF77calendar::days_from_timestamp(static_cast<uint32_t>(timestamp), secondOfDay);
+  const DCF77calendar::civil_t civil = DCF77calendar::civil_from_days(days);
+  uint8_t hour, minute, second;
+  DCF77calendar::hms_from_seconds(secondOfDay, hour, minute, second);
+
+  tm.tm_sec = second;
+  tm.tm_min = minute;
+  tm.tm_hour = hour;
+  tm.tm_mday = civil.mday;
+  tm.tm_mon = civil.month - 1;
+  tm.tm_year = civil.year - DCF77::TM_YEAR_BASE;
+  tm.tm_wday = civil.wday;
+  tm.tm_yday = civil.yday;
+  tm.tm_isdst = isdst;
+}
 
 } // namespace DCF77
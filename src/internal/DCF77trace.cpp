@@ -0,0 +1,159 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77trace.h"
+
+/*
+ * Record layout: The first byte holds the level in bit 7, a
+ * continuation flag in bit 6 and the low 6 bits of the delta time.
+ * Every continuation byte holds a continuation flag in bit 7 and the
+ * next 7 bits of the delta time.
+ */
+namespace {
+constexpr uint8_t LEVEL_BIT = 0x80;
+constexpr uint8_t FIRST_MORE = 0x40;
+constexpr uint8_t FIRST_DELTA_MASK = 0x3F;
+constexpr uint8_t MORE = 0x80;
+constexpr uint8_t DELTA_MASK = 0x7F;
+
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+constexpr uint8_t BYTES_PER_LINE = 32;
+}
+
+void DCF77trace::clear() {
+  mHead = 0;
+  mTail = 0;
+  mUsed = 0;
+  mEdges = 0;
+  mDropped = 0;
+}
+
+void DCF77trace::record(const int level, const uint32_t time) {
+  if (not mRecording) {
+    return;
+  }
+  uint32_t delta = 0;
+  if (mEdges == 0) {
+    mBaseTime = time;
+  } else {
+    delta = time - mLatestTime;
+  }
+  mLatestTime = time;
+
+  uint8_t bytes[MAX_RECORD_BYTES];
+  uint8_t count = 0;
+  bytes[count] = (level == LOW ? 0 : LEVEL_BIT) | (delta & FIRST_DELTA_MASK);
+  delta >>= 6;
+  while (delta != 0) {
+    bytes[count] |= count == 0 ? FIRST_MORE : MORE;
+    count++;
+    bytes[count] = delta & DELTA_MASK;
+    delta >>= 7;
+  }
+  count++;
+
+  while (mCapacity - mUsed < count) {
+    dropOldest();
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    mBuffer[mHead] = bytes[i];
+    if (++mHead == mCapacity) {
+      mHead = 0;
+    }
+  }
+  mUsed += count;
+  mEdges++;
+}
+
+void DCF77trace::dropOldest() {
+  uint8_t byte = takeOldestByte();
+  uint32_t delta = byte & FIRST_DELTA_MASK;
+  bool more = byte & FIRST_MORE;
+  uint8_t shift = 6;
+  while (more) {
+    byte = takeOldestByte();
+    delta |= static_cast<uint32_t>(byte & DELTA_MASK) << shift;
+    more = byte & MORE;
+    shift += 7;
+  }
+  mEdges--;
+  mDropped++;
+  // The dropped edge becomes the reference of the oldest one.
+  mBaseTime += delta;
+}
+
+size_t DCF77trace::dump(Print& out) {
+  const bool recording = mRecording;
+  mRecording = false;
+
+  size_t n = out.print("DCF77TRACE 1 ");
+  n += out.print(static_cast<unsigned long>(mTicksPerMilli));
+  n += out.print(' ');
+  n += out.print(static_cast<unsigned long>(mBaseTime));
+  n += out.print(' ');
+  n += out.print(static_cast<unsigned long>(mEdges));
+  n += out.print(' ');
+  n += out.print(static_cast<unsigned long>(mDropped));
+  n += out.println();
+
+  size_t position = mTail;
+  for (size_t i = 0; i < mUsed; i++) {
+    const uint8_t byte = mBuffer[position];
+    n += out.print(HEX_DIGITS[byte >> 4]);
+    n += out.print(HEX_DIGITS[byte & 0x0F]);
+    if (i % BYTES_PER_LINE == BYTES_PER_LINE - 1 || i == mUsed - 1) {
+      n += out.println();
+    }
+    if (++position == mCapacity) {
+      position = 0;
+    }
+  }
+  n += out.println("END");
+
+  mRecording = recording;
+  return n;
+}
+
+bool DCF77traceReader::next(int& level, uint32_t& time) {
+  if (mPosition >= mSize) {
+    return false;
+  }
+  uint8_t byte = mData[mPosition++];
+  level = byte & LEVEL_BIT ? HIGH : LOW;
+  uint32_t delta = byte & FIRST_DELTA_MASK;
+  bool more = byte & FIRST_MORE;
+  uint8_t shift = 6;
+  while (more) {
+    if (mPosition >= mSize) {
+      return false;
+    }
+    byte = mData[mPosition++];
+    delta |= static_cast<uint32_t>(byte & DELTA_MASK) << shift;
+    more = byte & MORE;
+    shift += 7;
+  }
+  mTime += delta;
+  time = mTime;
+  return true;
+}
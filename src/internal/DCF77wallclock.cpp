@@ -0,0 +1,211 @@
+/*
+  DCF77rxtm - Arduino libary receiving and decoding DCF77 frames Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/DCF77rxtm/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "DCF77wallclock.h"
+#include "DCF77rxbase.h"
+
+#include <Arduino.h>
+
+namespace {
+
+/* The error of a minute mark time stamp and of the read out, which
+ * are both truncated to milliseconds. */
+constexpr uint32_t MARK_ERROR_MILLIS = 3;
+/* Beyond this interval between two frames, the ticks may have wrapped. */
+constexpr uint32_t MAX_INTERVAL_SECONDS = 4000000;
+/* A frame, whose minute mark is further off the prediction, is wrong. */
+constexpr uint32_t MAX_PHASE_ERROR_MILLIS = 50;
+/* Time constant of the drift filter. */
+constexpr uint32_t DRIFT_FILTER_SECONDS = 600;
+/* ppm with 8 fractional bits per tick. */
+constexpr int64_t PPM_Q8_PER_TICK = 256000000;
+
+inline int32_t absolute(const int32_t v) {
+  return v < 0 ? -v : v;
+}
+
+} // anonymous namespace
+
+void DCF77wallclock::update(const uint64_t dcf77frame, const uint32_t systick) {
+  mLatestFrame.publish(dcf77frame, systick);
+}
+
+bool DCF77wallclock::refresh(unsigned* millisec) {
+  // update() may be called by onDCF77FrameReceived() within the
+  // interrupt context, or on the other core.
+  DCF77frameSnapshot latest;
+  mLatestFrame.read(latest);
+  const uint64_t dcf77frame = latest.frame;
+  const uint32_t systickAtFrame = latest.systick;
+
+  if (latest.sequence != mFrameCountSeen) {
+    // The only full conversion per frame. The frame carries the time
+    // of its minute mark, hence the seconds are 0.
+    mFrameCountSeen = latest.sequence;
+    DCF77rxbase::dcf77frame2time(mCachedTm, dcf77frame);
+    const DCF77::time_t utc = DCF77rxbase::dcf77frame2utc(dcf77frame);
+    mBaseTimestamp = utc + utcOffset();
+    if (mValid) {
+      discipline(static_cast<uint32_t>(utc - mBaseUtc), systickAtFrame - mSystickAtBase);
+    }
+    mBaseUtc = utc;
+    mSystickAtBase = systickAtFrame;
+    mCachedSeconds = 0;
+    mCachedSecondStart = 0;
+    mValid = true;
+  }
+
+  if (not mValid) {
+    return false;
+  }
+
+  // The elapsed ticks corrected by the drift estimate.
+  const uint32_t ticksSinceBase = millis() - mSystickAtBase;
+  const uint32_t millisSinceBase = ticksSinceBase
+      + static_cast<int32_t>((static_cast<int64_t>(ticksSinceBase) * mRateAdjust) >> 32);
+  uint32_t millisIntoSecond = millisSinceBase - mCachedSecondStart;
+  if (millisIntoSecond >= 1000) {
+    if (millisIntoSecond < 2000) {
+      // Advance to the next second without conversion.
+      mCachedSeconds++;
+      mCachedSecondStart += 1000;
+      millisIntoSecond -= 1000;
+      if (++mCachedTm.tm_sec == 60) {
+        mCachedTm.tm_sec = 0;
+        if (++mCachedTm.tm_min == 60) {
+          mCachedTm.tm_min = 0;
+          if (++mCachedTm.tm_hour == 24) {
+            // Day boundary: Date and weekday need a conversion.
+            DCF77::timestamp_to_tm(mCachedTm, mBaseTimestamp + mCachedSeconds, mCachedTm.tm_isdst);
+          }
+        }
+      }
+    } else {
+      // More than one second has passed since the last read.
+      mCachedSeconds = millisSinceBase / 1000;
+      mCachedSecondStart = mCachedSeconds * 1000;
+      millisIntoSecond = millisSinceBase - mCachedSecondStart;
+      DCF77::timestamp_to_tm(mCachedTm, mBaseTimestamp + mCachedSeconds, mCachedTm.tm_isdst);
+    }
+  }
+
+  if (millisec != nullptr) {
+    *millisec = millisIntoSecond;
+  }
+  return true;
+}
+
+void DCF77wallclock::discipline(const uint32_t seconds, const uint32_t ticks) {
+  if (seconds == 0 || seconds > MAX_INTERVAL_SECONDS) {
+    return;
+  }
+  const int64_t expected = static_cast<int64_t>(seconds) * 1000;
+  const int32_t errorTicks = static_cast<int32_t>(ticks - static_cast<uint32_t>(expected));
+  const int32_t measured = static_cast<int32_t>(errorTicks * PPM_Q8_PER_TICK / expected);
+  if (absolute(measured) > static_cast<int32_t>(DCF77_MAX_DRIFT_PPM) * 256) {
+    return;
+  }
+
+  if (mDriftCount == 0) {
+    mDriftPpmQ8 = measured;
+    // The uncertainty of the minute marks.
+    mDriftSpreadQ8 = static_cast<int32_t>(2 * MARK_ERROR_MILLIS * PPM_Q8_PER_TICK / expected);
+  } else {
+    // The phase error left by the prediction. A wrong minute mark or
+    // frame is far off.
+    const int32_t deviation = measured - mDriftPpmQ8;
+    const int64_t phaseError = deviation * expected / PPM_Q8_PER_TICK;
+    const int64_t phaseBound = MAX_PHASE_ERROR_MILLIS
+        + mDriftSpreadQ8 * expected / PPM_Q8_PER_TICK;
+    if (phaseError > phaseBound || phaseError < -phaseBound) {
+      return;
+    }
+    // A long interval measures the drift more precisely than a short
+    // one and gets more weight.
+    mDriftPpmQ8 += static_cast<int32_t>(static_cast<int64_t>(deviation) * seconds
+        / (seconds + DRIFT_FILTER_SECONDS));
+    mDriftSpreadQ8 += (absolute(deviation) - mDriftSpreadQ8) / 8;
+  }
+  if (mDriftCount < UINT8_MAX) {
+    mDriftCount++;
+  }
+  // Scale the ticks by 1 / (1 + drift), 1 + mRateAdjust / 2**32.
+  mRateAdjust = static_cast<int32_t>(-static_cast<int64_t>(mDriftPpmQ8) * 4294967296LL
+      / (PPM_Q8_PER_TICK + mDriftPpmQ8));
+}
+
+int64_t DCF77wallclock::driftBoundQ8() const {
+  // The spread of the single measurements is a conservative bound of
+  // the error of the estimate. It leaves room for a slow change of the
+  // drift, e.g. with the temperature.
+  return mDriftCount == 0 ?
+      static_cast<int64_t>(DCF77_MAX_DRIFT_PPM) * 256 : mDriftSpreadQ8 + 256;
+}
+
+uint32_t DCF77wallclock::holdoverErrorMillis() const {
+  const uint32_t ticksSinceBase = millis() - mSystickAtBase;
+  return MARK_ERROR_MILLIS
+      + static_cast<uint32_t>(ticksSinceBase * driftBoundQ8() / PPM_Q8_PER_TICK);
+}
+
+uint32_t DCF77wallclock::holdoverMillis(const uint32_t maxErrorMillis) const {
+  if (maxErrorMillis <= MARK_ERROR_MILLIS) {
+    return 0;
+  }
+  const int64_t ticks = (maxErrorMillis - MARK_ERROR_MILLIS) * PPM_Q8_PER_TICK / driftBoundQ8();
+  return ticks > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(ticks);
+}
+
+bool DCF77wallclock::getTime(DCF77::tm& tm, unsigned* millisec) {
+  if (refresh(millisec)) {
+    tm = mCachedTm;
+    return true;
+  }
+  return false;
+}
+
+bool DCF77wallclock::getTimestamp(DCF77::time_t& timestamp, unsigned* millisec) {
+  if (refresh(millisec)) {
+    timestamp = mBaseTimestamp + mCachedSeconds;
+    return true;
+  }
+  return false;
+}
+
+#if HAS_STD_CHRONO
+
+constexpr bool DCF77chronoClock::is_steady;
+DCF77wallclock* DCF77chronoClock::mSource = nullptr;
+
+DCF77chronoClock::time_point DCF77chronoClock::now() noexcept {
+  DCF77::time_t timestamp;
+  unsigned millisec;
+  if (mSource != nullptr && mSource->getTimestamp(timestamp, &millisec)) {
+    const rep utc = static_cast<rep>(timestamp) - mSource->utcOffset();
+    return time_point(duration(utc * 1000 + millisec));
+  }
+  return time_point();
+}
+
+#endif